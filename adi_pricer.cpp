@@ -0,0 +1,666 @@
+#include "adi_pricer.hpp"
+#include <cmath>
+#include <algorithm>
+#include <stdexcept>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+/* =========================================================
+   EDP À DEUX DIMENSIONS – SCHÉMAS ADI
+   ========================================================= */
+
+namespace
+{
+    // Poids implicite par défaut de chaque schéma
+    double default_theta(AdiPricer::Scheme scheme)
+    {
+        if (scheme == AdiPricer::Scheme::HundsdorferVerwer)
+            return 0.5 + std::sqrt(3.0) / 6.0;
+        return 0.5;
+    }
+}
+
+AdiPricer::AdiPricer(double maturity, double rate, std::size_t steps, bool is_american)
+    : T_(maturity), r_(rate), N_(steps), is_american_(is_american),
+      theta_(default_theta(Scheme::HundsdorferVerwer))
+{
+    if (maturity <= 0.0)
+        throw std::invalid_argument("Maturity must be positive");
+    if (steps == 0)
+        throw std::invalid_argument("Number of time steps must be positive");
+}
+
+void AdiPricer::set_grids(std::vector<double> x, std::vector<double> y, double x0, double y0)
+{
+    if (x.size() < 4 || y.size() < 4)
+        throw std::invalid_argument("ADI grids need at least 3 intervals per direction");
+    if (x0 < x.front() || x0 > x.back() || y0 < y.front() || y0 > y.back())
+        throw std::invalid_argument("Initial state outside the ADI grid");
+
+    x_ = std::move(x);
+    y_ = std::move(y);
+    x0_ = x0;
+    y0_ = y0;
+    solved_ = false;
+}
+
+void AdiPricer::set_scheme(Scheme scheme, double theta)
+{
+    if (theta > 1.0)
+        throw std::invalid_argument("ADI theta must be in (0, 1]");
+
+    scheme_ = scheme;
+    theta_ = theta > 0.0 ? theta : default_theta(scheme);
+    solved_ = false;
+}
+
+void AdiPricer::set_damping_steps(std::size_t steps)
+{
+    damping_steps_ = steps;
+    solved_ = false;
+}
+
+std::vector<double> AdiPricer::sinh_grid(double lower, double upper, double centre,
+                                         double alpha, std::size_t points)
+{
+    double c1 = std::asinh((lower - centre) / alpha);
+    double c2 = std::asinh((upper - centre) / alpha);
+
+    std::vector<double> nodes(points + 1);
+    for (std::size_t m = 0; m <= points; ++m)
+        nodes[m] = centre + alpha * std::sinh(c1 + (c2 - c1) * static_cast<double>(m) / static_cast<double>(points));
+    nodes.front() = lower;
+    nodes.back() = upper;
+    return nodes;
+}
+
+double AdiPricer::price() const
+{
+    return evaluate(x0_, y0_, nullptr, nullptr, nullptr);
+}
+
+double AdiPricer::delta(double spot) const
+{
+    double dx = 0.0;
+    evaluate(spot, y0_, &dx, nullptr, nullptr);
+    return dx;
+}
+
+double AdiPricer::gamma(double spot) const
+{
+    double dxx = 0.0;
+    evaluate(spot, y0_, nullptr, &dxx, nullptr);
+    return dxx;
+}
+
+void AdiPricer::ensure_solved() const
+{
+    if (!solved_)
+        solve();
+}
+
+void AdiPricer::build_operators(Operators& op) const
+{
+    std::size_t nx = x_.size(), ny = y_.size(), size = nx * ny;
+
+    op.lower1.assign(size, 0.0); op.diag1.assign(size, 0.0); op.upper1.assign(size, 0.0);
+    op.lower2.assign(size, 0.0); op.diag2.assign(size, 0.0); op.upper2.assign(size, 0.0);
+    op.cross.assign(size, 0.0);
+    op.weight_x.assign(3 * nx, 0.0);
+    op.weight_y.assign(3 * ny, 0.0);
+
+    // Stencil à trois points de la direction k au nœud m : dérivées première
+    // (centrée à l'intérieur, décentrée vers l'intérieur aux bords) et seconde
+    // (nulle aux bords), combinées avec les coefficients de diffusion et de convection
+    auto stencil = [&](const std::vector<double>& nodes, std::size_t m,
+                       double diffusion, double convection,
+                       double& lower, double& diag, double& upper)
+    {
+        std::size_t last = nodes.size() - 1;
+        if (m == 0)
+        {
+            double h = nodes[1] - nodes[0];
+            lower = 0.0;
+            diag = -convection / h;
+            upper = convection / h;
+        }
+        else if (m == last)
+        {
+            double h = nodes[last] - nodes[last - 1];
+            lower = -convection / h;
+            diag = convection / h;
+            upper = 0.0;
+        }
+        else
+        {
+            double hm = nodes[m] - nodes[m - 1], hp = nodes[m + 1] - nodes[m], hs = hm + hp;
+            lower = diffusion * 2.0 / (hm * hs) - convection * hp / (hm * hs);
+            diag = -diffusion * 2.0 / (hm * hp) + convection * (hp - hm) / (hm * hp);
+            upper = diffusion * 2.0 / (hp * hs) + convection * hm / (hp * hs);
+        }
+        diag -= 0.5 * r_;
+    };
+
+    auto central = [](const std::vector<double>& nodes, std::size_t m, double* w)
+    {
+        double hm = nodes[m] - nodes[m - 1], hp = nodes[m + 1] - nodes[m], hs = hm + hp;
+        w[0] = -hp / (hm * hs);
+        w[1] = (hp - hm) / (hm * hp);
+        w[2] = hm / (hp * hs);
+    };
+
+    for (std::size_t i = 1; i + 1 < nx; ++i)
+        central(x_, i, &op.weight_x[3 * i]);
+    for (std::size_t j = 1; j + 1 < ny; ++j)
+        central(y_, j, &op.weight_y[3 * j]);
+
+    for (std::size_t j = 0; j < ny; ++j)
+        for (std::size_t i = 0; i < nx; ++i)
+        {
+            std::size_t k = j * nx + i;
+            Coefficients c = coefficients(x_[i], y_[j]);
+            stencil(x_, i, c.xx, c.x, op.lower1[k], op.diag1[k], op.upper1[k]);
+            stencil(y_, j, c.yy, c.y, op.lower2[k], op.diag2[k], op.upper2[k]);
+            if (i > 0 && i + 1 < nx && j > 0 && j + 1 < ny)
+                op.cross[k] = c.xy;
+        }
+}
+
+void AdiPricer::factorize(const Operators& op, double step, Factorization& f) const
+{
+    std::size_t nx = x_.size(), ny = y_.size(), size = nx * ny;
+
+    f.ratio1.assign(size, 0.0); f.inverse_pivot1.assign(size, 0.0); f.upper1.assign(size, 0.0);
+    f.ratio2.assign(size, 0.0); f.inverse_pivot2.assign(size, 0.0); f.upper2.assign(size, 0.0);
+
+    for (std::size_t k = 0; k < size; ++k)
+    {
+        f.upper1[k] = -step * op.upper1[k];
+        f.upper2[k] = -step * op.upper2[k];
+    }
+
+    // Lignes pour A1
+    for (std::size_t j = 0; j < ny; ++j)
+    {
+        std::size_t k = j * nx;
+        f.inverse_pivot1[k] = 1.0 / (1.0 - step * op.diag1[k]);
+        for (std::size_t i = 1; i < nx; ++i)
+        {
+            ++k;
+            f.ratio1[k] = -step * op.lower1[k] * f.inverse_pivot1[k - 1];
+            f.inverse_pivot1[k] = 1.0 / (1.0 - step * op.diag1[k] - f.ratio1[k] * f.upper1[k - 1]);
+        }
+    }
+
+    // Colonnes pour A2, toutes les colonnes d'une ligne à la fois
+    for (std::size_t i = 0; i < nx; ++i)
+        f.inverse_pivot2[i] = 1.0 / (1.0 - step * op.diag2[i]);
+    for (std::size_t j = 1; j < ny; ++j)
+        for (std::size_t i = 0; i < nx; ++i)
+        {
+            std::size_t k = j * nx + i;
+            f.ratio2[k] = -step * op.lower2[k] * f.inverse_pivot2[k - nx];
+            f.inverse_pivot2[k] = 1.0 / (1.0 - step * op.diag2[k] - f.ratio2[k] * f.upper2[k - nx]);
+        }
+}
+
+void AdiPricer::apply(const Operators& op, const double* U, double* A0U, double* A1U, double* A2U,
+                      std::size_t begin, std::size_t end) const
+{
+    std::size_t nx = x_.size(), ny = y_.size();
+
+    for (std::size_t j = begin; j < end; ++j)
+    {
+        std::size_t row = j * nx;
+        const double* u = U + row;
+        const double* lower1 = op.lower1.data() + row;
+        const double* diag1 = op.diag1.data() + row;
+        const double* upper1 = op.upper1.data() + row;
+        const double* below = j > 0 ? u - nx : u;
+        const double* above = j + 1 < ny ? u + nx : u;
+
+        // Direction x : lignes contiguës
+        if (A1U)
+        {
+            double* a1 = A1U + row;
+            a1[0] = diag1[0] * u[0] + upper1[0] * u[1];
+            for (std::size_t i = 1; i + 1 < nx; ++i)
+                a1[i] = lower1[i] * u[i - 1] + diag1[i] * u[i] + upper1[i] * u[i + 1];
+            a1[nx - 1] = lower1[nx - 1] * u[nx - 2] + diag1[nx - 1] * u[nx - 1];
+        }
+
+        // Direction y : combinaison des lignes voisines
+        if (A2U)
+        {
+            const double* lower2 = op.lower2.data() + row;
+            const double* diag2 = op.diag2.data() + row;
+            const double* upper2 = op.upper2.data() + row;
+            double* a2 = A2U + row;
+            for (std::size_t i = 0; i < nx; ++i)
+                a2[i] = lower2[i] * below[i] + diag2[i] * u[i] + upper2[i] * above[i];
+        }
+
+        // Dérivée croisée : produit des stencils centrés, nœuds intérieurs seulement
+        double* a0 = A0U + row;
+        a0[0] = a0[nx - 1] = 0.0;
+        if (j == 0 || j + 1 == ny)
+        {
+            std::fill(a0, a0 + nx, 0.0);
+            continue;
+        }
+        const double* wy = &op.weight_y[3 * j];
+        const double* cross = op.cross.data() + row;
+        for (std::size_t i = 1; i + 1 < nx; ++i)
+        {
+            const double* wx = &op.weight_x[3 * i];
+            double mixed = wy[0] * (wx[0] * below[i - 1] + wx[1] * below[i] + wx[2] * below[i + 1])
+                         + wy[1] * (wx[0] * u[i - 1] + wx[1] * u[i] + wx[2] * u[i + 1])
+                         + wy[2] * (wx[0] * above[i - 1] + wx[1] * above[i] + wx[2] * above[i + 1]);
+            a0[i] = cross[i] * mixed;
+        }
+    }
+}
+
+void AdiPricer::solve_rows(const Factorization& f, double* V, std::size_t begin, std::size_t end) const
+{
+    std::size_t nx = x_.size();
+
+    for (std::size_t j = begin; j < end; ++j)
+    {
+        std::size_t row = j * nx;
+        double* v = V + row;
+        const double* ratio = f.ratio1.data() + row;
+        const double* inverse_pivot = f.inverse_pivot1.data() + row;
+        const double* upper = f.upper1.data() + row;
+
+        for (std::size_t i = 1; i < nx; ++i)
+            v[i] -= ratio[i] * v[i - 1];
+        v[nx - 1] *= inverse_pivot[nx - 1];
+        for (std::size_t i = nx - 1; i-- > 0;)
+            v[i] = (v[i] - upper[i] * v[i + 1]) * inverse_pivot[i];
+    }
+}
+
+void AdiPricer::solve_columns(const Factorization& f, double* V, std::size_t begin, std::size_t end) const
+{
+    std::size_t nx = x_.size(), ny = y_.size();
+
+    for (std::size_t j = 1; j < ny; ++j)
+    {
+        std::size_t row = j * nx;
+        const double* ratio = f.ratio2.data() + row;
+        double* v = V + row;
+        const double* below = v - nx;
+        for (std::size_t i = begin; i < end; ++i)
+            v[i] -= ratio[i] * below[i];
+    }
+
+    {
+        std::size_t row = (ny - 1) * nx;
+        for (std::size_t i = begin; i < end; ++i)
+            V[row + i] *= f.inverse_pivot2[row + i];
+    }
+
+    for (std::size_t j = ny - 1; j-- > 0;)
+    {
+        std::size_t row = j * nx;
+        const double* upper = f.upper2.data() + row;
+        const double* inverse_pivot = f.inverse_pivot2.data() + row;
+        double* v = V + row;
+        const double* above = v + nx;
+        for (std::size_t i = begin; i < end; ++i)
+            v[i] = (v[i] - upper[i] * above[i]) * inverse_pivot[i];
+    }
+}
+
+void AdiPricer::solve() const
+{
+    std::size_t nx = x_.size(), ny = y_.size(), size = nx * ny;
+    double dt = T_ / static_cast<double>(N_);
+    double theta_dt = theta_ * dt;
+
+    Operators op;
+    build_operators(op);
+
+    Factorization main, damped;
+    factorize(op, theta_dt, main);
+    if (damping_steps_ > 0)
+        factorize(op, 0.5 * dt, damped);
+
+    std::vector<double> obstacle(size);
+    for (std::size_t j = 0; j < ny; ++j)
+        for (std::size_t i = 0; i < nx; ++i)
+            obstacle[j * nx + i] = payoff(x_[i], y_[j]);
+
+    // U : tranche courante ; Y0 : prédicteur explicite ; Y : étapes de
+    // Douglas (Y2) ; Z : étapes correctrices ; A*U et B* = A* Y2
+    std::vector<double> U = obstacle, Y0(size), Y(size), Z(size);
+    std::vector<double> A0U(size), A1U(size), A2U(size);
+    std::vector<double> B0(scheme_ == Scheme::Douglas ? 0 : size);
+    std::vector<double> B1(scheme_ == Scheme::HundsdorferVerwer ? size : 0), B2(B1.size());
+
+    std::size_t workers = threads_ ? threads_ : std::max<std::size_t>(1, std::thread::hardware_concurrency());
+    workers = std::min({workers, nx, ny});
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::size_t arrived = 0, generation = 0;
+    auto sync = [&]()
+    {
+        if (workers == 1)
+            return;
+        std::unique_lock<std::mutex> lock(mutex);
+        std::size_t current = generation;
+        if (++arrived == workers)
+        {
+            arrived = 0;
+            ++generation;
+            cv.notify_all();
+        }
+        else
+        {
+            cv.wait(lock, [&] { return generation != current; });
+        }
+    };
+
+    // Chaque thread traite un bloc de lignes (direction x, opérateurs) puis
+    // un bloc de colonnes (direction y) ; barrière entre les deux
+    auto work = [&](std::size_t w)
+    {
+        std::size_t row_begin = w * ny / workers, row_end = (w + 1) * ny / workers;
+        std::size_t column_begin = w * nx / workers, column_end = (w + 1) * nx / workers;
+
+        double* u = U.data();
+        double* y = Y.data();
+        double* z = Z.data();
+
+        // Second membre colonne par colonne puis solve (I - step A2), contrainte américaine
+        auto finish_columns = [&](const Factorization& f, double step, double* v, const double* A2)
+        {
+            for (std::size_t j = 0; j < ny; ++j)
+                for (std::size_t i = column_begin; i < column_end; ++i)
+                    v[j * nx + i] -= step * A2[j * nx + i];
+            solve_columns(f, v, column_begin, column_end);
+            if (is_american_)
+                for (std::size_t j = 0; j < ny; ++j)
+                    for (std::size_t i = column_begin; i < column_end; ++i)
+                        v[j * nx + i] = std::max(v[j * nx + i], obstacle[j * nx + i]);
+        };
+
+        // Douglas sur un pas h : prédicteur Y0 = U + h A U, puis
+        // (I - step A1) Y1 = Y0 - step A1 U et (I - step A2) Y2 = Y1 - step A2 U
+        auto douglas = [&](const Factorization& f, double h, double step)
+        {
+            apply(op, u, A0U.data(), A1U.data(), A2U.data(), row_begin, row_end);
+            for (std::size_t k = row_begin * nx; k < row_end * nx; ++k)
+            {
+                Y0[k] = u[k] + h * (A0U[k] + A1U[k] + A2U[k]);
+                y[k] = Y0[k] - step * A1U[k];
+            }
+            solve_rows(f, y, row_begin, row_end);
+            sync();
+
+            finish_columns(f, step, y, A2U.data());
+            sync();
+        };
+
+        for (std::size_t n = 0; n < N_; ++n)
+        {
+            if (n < damping_steps_)
+            {
+                for (int half = 0; half < 2; ++half)
+                {
+                    douglas(damped, 0.5 * dt, 0.5 * dt);
+                    std::swap(u, y);
+                }
+                continue;
+            }
+
+            douglas(main, dt, theta_dt);
+
+            if (scheme_ == Scheme::Douglas)
+            {
+                std::swap(u, y);
+                continue;
+            }
+
+            if (scheme_ == Scheme::CraigSneyd)
+            {
+                // Z0 = Y0 + dt/2 (A0 Y2 - A0 U), Z1 : (I - theta dt A1) Z1 = Z0 - theta dt A1 U
+                apply(op, y, B0.data(), nullptr, nullptr, row_begin, row_end);
+                for (std::size_t k = row_begin * nx; k < row_end * nx; ++k)
+                    z[k] = Y0[k] + 0.5 * dt * (B0[k] - A0U[k]) - theta_dt * A1U[k];
+                solve_rows(main, z, row_begin, row_end);
+                sync();
+
+                finish_columns(main, theta_dt, z, A2U.data());
+                sync();
+            }
+            else
+            {
+                // Z0 = Y0 + dt/2 (A Y2 - A U), Z1 : (I - theta dt A1) Z1 = Z0 - theta dt A1 Y2
+                apply(op, y, B0.data(), B1.data(), B2.data(), row_begin, row_end);
+                for (std::size_t k = row_begin * nx; k < row_end * nx; ++k)
+                    z[k] = Y0[k] + 0.5 * dt * (B0[k] + B1[k] + B2[k] - A0U[k] - A1U[k] - A2U[k])
+                         - theta_dt * B1[k];
+                solve_rows(main, z, row_begin, row_end);
+                sync();
+
+                finish_columns(main, theta_dt, z, B2.data());
+                sync();
+            }
+            std::swap(u, z);
+        }
+
+        if (w == 0)
+            solution_.assign(u, u + size);
+    };
+
+    std::vector<std::thread> pool;
+    for (std::size_t w = 1; w < workers; ++w)
+        pool.emplace_back(work, w);
+    work(0);
+    for (auto& thread : pool)
+        thread.join();
+
+    solved_ = true;
+}
+
+std::size_t AdiPricer::lagrange_weights(const std::vector<double>& nodes, double x,
+                                        double w[4], double dw[4], double d2w[4])
+{
+    std::size_t position = static_cast<std::size_t>(std::upper_bound(nodes.begin(), nodes.end(), x) - nodes.begin());
+    std::size_t first = position >= 2 ? position - 2 : 0;
+    first = std::min(first, nodes.size() - 4);
+
+    // L_k = a b c / den, L_k' = (ab + bc + ca) / den, L_k'' = 2 (a + b + c) / den
+    for (std::size_t k = 0; k < 4; ++k)
+    {
+        double den = 1.0, d[3];
+        std::size_t m = 0;
+        for (std::size_t l = 0; l < 4; ++l)
+        {
+            if (l == k)
+                continue;
+            den *= nodes[first + k] - nodes[first + l];
+            d[m++] = x - nodes[first + l];
+        }
+        w[k] = d[0] * d[1] * d[2] / den;
+        dw[k] = (d[0] * d[1] + d[1] * d[2] + d[2] * d[0]) / den;
+        d2w[k] = 2.0 * (d[0] + d[1] + d[2]) / den;
+    }
+    return first;
+}
+
+double AdiPricer::evaluate(double x, double y, double* dx, double* dxx, double* dy) const
+{
+    if (x < x_.front() || x > x_.back() || y < y_.front() || y > y_.back())
+        throw std::invalid_argument("Point outside the ADI grid");
+
+    ensure_solved();
+
+    double wx[4], dwx[4], d2wx[4], wy[4], dwy[4], d2wy[4];
+    std::size_t i0 = lagrange_weights(x_, x, wx, dwx, d2wx);
+    std::size_t j0 = lagrange_weights(y_, y, wy, dwy, d2wy);
+    std::size_t nx = x_.size();
+
+    double value = 0.0, first = 0.0, second = 0.0, across = 0.0;
+    for (std::size_t l = 0; l < 4; ++l)
+    {
+        const double* row = solution_.data() + (j0 + l) * nx + i0;
+        double v = 0.0, v1 = 0.0, v2 = 0.0;
+        for (std::size_t k = 0; k < 4; ++k)
+        {
+            v += wx[k] * row[k];
+            v1 += dwx[k] * row[k];
+            v2 += d2wx[k] * row[k];
+        }
+        value += wy[l] * v;
+        first += wy[l] * v1;
+        second += wy[l] * v2;
+        across += dwy[l] * v;
+    }
+
+    if (dx)
+        *dx = first;
+    if (dxx)
+        *dxx = second;
+    if (dy)
+        *dy = across;
+    return value;
+}
+
+/* =========================================================
+   HESTON
+   ========================================================= */
+
+HestonAdiPricer::HestonAdiPricer(const Option& option,
+                                 double spot,
+                                 double rate,
+                                 double carry,
+                                 double variance,
+                                 double mean_reversion,
+                                 double long_variance,
+                                 double vol_of_vol,
+                                 double correlation,
+                                 std::size_t spot_points,
+                                 std::size_t variance_points,
+                                 std::size_t steps,
+                                 bool is_american)
+    : AdiPricer(option.maturity(), rate, steps, is_american),
+      option_(option),
+      b_(carry),
+      kappa_(mean_reversion),
+      long_variance_(long_variance),
+      xi_(vol_of_vol),
+      rho_(correlation)
+{
+    // Validation
+    if (spot <= 0.0)
+        throw std::invalid_argument("Spot must be positive");
+    if (variance < 0.0 || long_variance <= 0.0)
+        throw std::invalid_argument("Variances must be positive");
+    if (mean_reversion <= 0.0 || vol_of_vol <= 0.0)
+        throw std::invalid_argument("Mean reversion and vol of vol must be positive");
+    if (correlation < -1.0 || correlation > 1.0)
+        throw std::invalid_argument("Correlation must be in [-1, 1]");
+
+    double K = option.payoff().strike();
+    if (K <= 0.0)
+        throw std::invalid_argument("Heston ADI grid needs a positive strike");
+
+    double Smax = kSpotWidth * std::max(spot, K);
+    double vmax = std::max(kMinMaxVariance, kVarianceWidth * std::max(variance, long_variance));
+
+    set_grids(sinh_grid(0.0, Smax, K, kSpotConcentration * K, spot_points),
+              sinh_grid(0.0, vmax, 0.0, kVarianceConcentration * vmax, variance_points),
+              spot, variance);
+}
+
+AdiPricer::Coefficients HestonAdiPricer::coefficients(double S, double v) const
+{
+    return {0.5 * S * S * v,
+            rho_ * xi_ * S * v,
+            0.5 * xi_ * xi_ * v,
+            b_ * S,
+            kappa_ * (long_variance_ - v)};
+}
+
+double HestonAdiPricer::payoff(double S, double) const
+{
+    return option_.payoff().payoff_spot(S);
+}
+
+double HestonAdiPricer::variance_delta() const
+{
+    double dv = 0.0;
+    evaluate(x0_, y0_, nullptr, nullptr, &dv);
+    return dv;
+}
+
+double HestonAdiPricer::vega() const
+{
+    return 2.0 * std::sqrt(y0_) * variance_delta();
+}
+
+/* =========================================================
+   DEUX SOUS-JACENTS
+   ========================================================= */
+
+TwoAssetAdiPricer::TwoAssetAdiPricer(const TwoAssetPayoff& payoff,
+                                     double maturity,
+                                     double spot1,
+                                     double spot2,
+                                     double rate,
+                                     double carry1,
+                                     double carry2,
+                                     double volatility1,
+                                     double volatility2,
+                                     double correlation,
+                                     std::size_t points1,
+                                     std::size_t points2,
+                                     std::size_t steps,
+                                     bool is_american)
+    : AdiPricer(maturity, rate, steps, is_american),
+      payoff_(payoff),
+      b1_(carry1),
+      b2_(carry2),
+      sigma1_(volatility1),
+      sigma2_(volatility2),
+      rho_(correlation)
+{
+    // Validation
+    if (spot1 <= 0.0 || spot2 <= 0.0)
+        throw std::invalid_argument("Spots must be positive");
+    if (volatility1 <= 0.0 || volatility2 <= 0.0)
+        throw std::invalid_argument("Volatilities must be positive");
+    if (correlation < -1.0 || correlation > 1.0)
+        throw std::invalid_argument("Correlation must be in [-1, 1]");
+
+    double width1 = volatility1 * std::sqrt(maturity), width2 = volatility2 * std::sqrt(maturity);
+    set_grids(sinh_grid(0.0, spot1 * std::exp(kDomainWidth * width1), spot1, kConcentration * spot1 * width1, points1),
+              sinh_grid(0.0, spot2 * std::exp(kDomainWidth * width2), spot2, kConcentration * spot2 * width2, points2),
+              spot1, spot2);
+}
+
+AdiPricer::Coefficients TwoAssetAdiPricer::coefficients(double S1, double S2) const
+{
+    return {0.5 * sigma1_ * sigma1_ * S1 * S1,
+            rho_ * sigma1_ * sigma2_ * S1 * S2,
+            0.5 * sigma2_ * sigma2_ * S2 * S2,
+            b1_ * S1,
+            b2_ * S2};
+}
+
+double TwoAssetAdiPricer::payoff(double S1, double S2) const
+{
+    return payoff_(S1, S2);
+}
+
+double TwoAssetAdiPricer::delta2() const
+{
+    double d2 = 0.0;
+    evaluate(x0_, y0_, nullptr, nullptr, &d2);
+    return d2;
+}
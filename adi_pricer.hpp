@@ -0,0 +1,223 @@
+#pragma once
+
+#include "pricer.hpp"
+#include "option.hpp"
+#include "payoff.hpp"
+#include <vector>
+
+/* =========================================================
+   EDP À DEUX DIMENSIONS – SCHÉMAS ADI
+   ========================================================= */
+
+// EDP de valorisation en deux variables d'état (x, y), résolue en temps
+// restant tau :
+//   V_tau = a_xx V_xx + a_xy V_xy + a_yy V_yy + b_x V_x + b_y V_y - r V
+// Grilles non uniformes (sinh) dans les variables d'origine, différences à
+// trois points ; aux bords, dérivée première décentrée vers l'intérieur et
+// dérivée seconde nulle (condition linéaire). L'opérateur est découpé en
+// A0 (dérivée croisée, explicite), A1 (direction x) et A2 (direction y),
+// -r V étant partagé entre A1 et A2. Les systèmes (I - theta dt A_k) sont
+// factorisés une fois par résolution : chaque demi-pas ADI est une série de
+// solves tridiagonaux indépendants par ligne (x) ou par colonne (y), répartis
+// par blocs entre threads. Exercice américain par projection sur le payoff
+// après chaque pas.
+class AdiPricer : public Pricer
+{
+public:
+    enum class Scheme
+    {
+        Douglas,           // Un prédicteur, theta = 1/2 (premier ordre avec dérivée croisée)
+        CraigSneyd,        // Correction de la dérivée croisée, theta = 1/2 (second ordre)
+        HundsdorferVerwer  // Correction de tout l'opérateur, theta = 1/2 + sqrt(3)/6 (second ordre, robuste)
+    };
+
+    double price() const override;
+
+    // Dérivées par rapport à la première variable (S ou S1), lues sur la
+    // résolution en cache (interpolation de Lagrange cubique). Le spot doit
+    // rester dans la grille
+    double delta(double spot) const override;
+    double gamma(double spot) const override;
+
+    // theta <= 0 : valeur par défaut du schéma
+    void set_scheme(Scheme scheme, double theta = 0.0);
+    Scheme scheme() const { return scheme_; }
+
+    // Threads des solves par ligne (0 : tous les cœurs). Le résultat ne
+    // dépend pas du nombre de threads
+    void set_threads(std::size_t threads) { threads_ = threads; }
+    std::size_t threads() const { return threads_; }
+
+    // Démarrage amorti (Rannacher) : les premiers pas sont remplacés chacun
+    // par deux demi-pas de Douglas avec theta = 1, qui lissent le coude du
+    // payoff (gamma sans oscillation près du strike)
+    void set_damping_steps(std::size_t steps);
+    std::size_t damping_steps() const { return damping_steps_; }
+
+    std::size_t get_steps() const { return N_; }
+
+protected:
+    // Coefficients de l'EDP en un nœud
+    struct Coefficients
+    {
+        double xx, xy, yy;  // Diffusion
+        double x, y;        // Convection
+    };
+
+    AdiPricer(double maturity, double rate, std::size_t steps, bool is_american);
+
+    // Appelé par le constructeur dérivé : nœuds des deux directions et point
+    // d'évaluation (x0, y0)
+    void set_grids(std::vector<double> x, std::vector<double> y, double x0, double y0);
+
+    virtual Coefficients coefficients(double x, double y) const = 0;
+    virtual double payoff(double x, double y) const = 0;
+
+    // Valeur et dérivées de la solution en (x, y) ; pointeurs nuls ignorés
+    double evaluate(double x, double y, double* dx, double* dxx, double* dy) const;
+
+    // Grille sinh de [lower, upper] concentrée autour de centre, largeur
+    // de la zone dense alpha
+    static std::vector<double> sinh_grid(double lower, double upper, double centre,
+                                         double alpha, std::size_t points);
+
+    double x0_ = 0.0, y0_ = 0.0;
+
+private:
+    // Opérateurs discrets, fixes pendant la remontée
+    struct Operators
+    {
+        // A1 le long des lignes, A2 le long des colonnes : (A U)_k = lower U_(k-1) + diag U_k + upper U_(k+1)
+        std::vector<double> lower1, diag1, upper1, lower2, diag2, upper2;
+        // Dérivée croisée aux nœuds intérieurs : a_xy * poids centrés en x et en y
+        std::vector<double> cross, weight_x, weight_y;
+    };
+
+    // Factorisations de (I - step A1) par ligne et de (I - step A2) par colonne
+    struct Factorization
+    {
+        std::vector<double> ratio1, inverse_pivot1, upper1;
+        std::vector<double> ratio2, inverse_pivot2, upper2;
+    };
+
+    void ensure_solved() const;
+    void solve() const;
+    void build_operators(Operators& op) const;
+    void factorize(const Operators& op, double step, Factorization& f) const;
+
+    // (A0 U, A1 U, A2 U) sur les lignes [begin, end) ; A1U, A2U nuls : non calculés
+    void apply(const Operators& op, const double* U, double* A0U, double* A1U, double* A2U,
+               std::size_t begin, std::size_t end) const;
+
+    // Solves (I - step A1) en place sur les lignes [begin, end)
+    void solve_rows(const Factorization& f, double* V, std::size_t begin, std::size_t end) const;
+
+    // Solves (I - step A2) en place sur les colonnes [begin, end) : la
+    // substitution avance ligne par ligne sur tout le bloc de colonnes
+    void solve_columns(const Factorization& f, double* V, std::size_t begin, std::size_t end) const;
+
+    // Poids de Lagrange à quatre points (valeur, dérivées première et seconde)
+    static std::size_t lagrange_weights(const std::vector<double>& nodes, double x,
+                                        double w[4], double dw[4], double d2w[4]);
+
+    static constexpr std::size_t kDefaultDampingSteps = 2;
+
+    double T_, r_;
+    std::size_t N_;
+    bool is_american_;
+    Scheme scheme_ = Scheme::HundsdorferVerwer;
+    double theta_;
+    std::size_t damping_steps_ = kDefaultDampingSteps;
+    std::size_t threads_ = 1;
+
+    std::vector<double> x_, y_;
+
+    // Dernière résolution : tranche tau = T, x le plus rapide
+    mutable bool solved_ = false;
+    mutable std::vector<double> solution_;
+};
+
+/* =========================================================
+   HESTON – OPTION EUROPÉENNE OU AMÉRICAINE (S x v)
+   ========================================================= */
+
+// dS = b S dt + sqrt(v) S dW1, dv = kappa (theta - v) dt + xi sqrt(v) dW2,
+// corrélation rho. Grille en S sur [0, kSpotWidth max(S0, K)], concentrée
+// sur K ; grille en v sur [0, v_max], concentrée près de 0 (In 't Hout -
+// Foulon). En S = 0 et v = 0 l'EDP dégénère et s'applique telle quelle.
+class HestonAdiPricer : public AdiPricer
+{
+public:
+    HestonAdiPricer(const Option& option,
+                    double spot,
+                    double rate,
+                    double carry,
+                    double variance,          // v0
+                    double mean_reversion,    // kappa
+                    double long_variance,     // theta
+                    double vol_of_vol,        // xi
+                    double correlation,       // rho
+                    std::size_t spot_points = 200,
+                    std::size_t variance_points = 100,
+                    std::size_t steps = 50,
+                    bool is_american = false);
+
+    // dV/dv0 et vega par rapport à la volatilité initiale sqrt(v0)
+    double variance_delta() const;
+    double vega() const override;
+
+protected:
+    Coefficients coefficients(double S, double v) const override;
+    double payoff(double S, double v) const override;
+
+private:
+    static constexpr double kSpotWidth = 8.0;       // S_max en multiples de max(S0, K)
+    static constexpr double kVarianceWidth = 10.0;  // v_max en multiples de max(v0, theta)
+    static constexpr double kMinMaxVariance = 1.0;
+    static constexpr double kSpotConcentration = 0.2;       // Zone dense en S, en multiples de K
+    static constexpr double kVarianceConcentration = 0.002; // Zone dense en v, en multiples de v_max
+
+    const Option& option_;
+    double b_;
+    double kappa_, long_variance_, xi_, rho_;
+};
+
+/* =========================================================
+   DEUX SOUS-JACENTS – ÉCHANGE, SPREAD, BEST-OF, WORST-OF (S1 x S2)
+   ========================================================= */
+
+// Black-Scholes bidimensionnel. Chaque direction couvre
+// [0, S_k exp(kDomainWidth sigma_k sqrt(T))], nœuds concentrés sur S_k.
+class TwoAssetAdiPricer : public AdiPricer
+{
+public:
+    TwoAssetAdiPricer(const TwoAssetPayoff& payoff,
+                      double maturity,
+                      double spot1,
+                      double spot2,
+                      double rate,
+                      double carry1,
+                      double carry2,
+                      double volatility1,
+                      double volatility2,
+                      double correlation,
+                      std::size_t points1 = 200,
+                      std::size_t points2 = 200,
+                      std::size_t steps = 50,
+                      bool is_american = false);
+
+    // Delta par rapport au second sous-jacent, au spot initial
+    double delta2() const;
+
+protected:
+    Coefficients coefficients(double S1, double S2) const override;
+    double payoff(double S1, double S2) const override;
+
+private:
+    static constexpr double kDomainWidth = 6.0;
+    static constexpr double kConcentration = 0.5;  // Largeur de la zone dense en S_k sigma_k sqrt(T)
+
+    TwoAssetPayoff payoff_;
+    double b1_, b2_;
+    double sigma1_, sigma2_, rho_;
+};
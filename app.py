@@ -135,6 +135,8 @@ def calculate_option_price():
             
             elif pricing_method == "FiniteDifference":
                 pricer = opc.FiniteDifferenceAmericanPricer(option, spot, rate, rate, volatility, fd_M, fd_N, opc.FDScheme.CrankNicolson)
+                # Greeks lus sur la solution : démarrage de Rannacher (gamma lisse au strike)
+                pricer.set_rannacher_steps(2)
             
             # Calculer prix et Greeks
             price = pricer.price()
@@ -249,22 +251,35 @@ if st.session_state.results:
         
         opt_type_enum = opc.OptionType.Call if option_type == "Call" else opc.OptionType.Put
         
-        # Utiliser uniquement des options européennes pour les graphiques de sensibilité
+        # Différences finies : profil V(S) lu sur la résolution du prix affiché
+        # (même option, grille et exercice), sans nouveau pricer par spot
+        ladder = None
+        if pricing_method == "FiniteDifference":
+            try:
+                ladder = results['pricer'].price_profile(list(spots))
+            except Exception as e:
+                st.warning(f"⚠️ Profil différences finies indisponible : {str(e)}")
+        
+        # Hors différences finies : options européennes pour les graphiques de sensibilité
         # pour éviter les erreurs avec les options exotiques non implémentées
-        for s in spots:
+        for k, s in enumerate(spots):
             try:
-                # Toujours utiliser une option européenne pour la sensibilité
-                payoff_temp = opc.create_payoff(opc.PayoffStyle.European, opt_type_enum, strike)
-                option_temp = opc.Option(maturity, payoff_temp)
-                
-                if pricing_method == "BlackScholes":
-                    pricer_temp = opc.BlackScholesPricer(option_temp, s, rate, rate, volatility)
+                if ladder is not None:
+                    prices.append(ladder.prices[k])
+                    deltas.append(ladder.deltas[k])
                 else:
-                    # Utiliser arbre binomial pour les autres méthodes
-                    pricer_temp = opc.BinomialTreePricer(option_temp, s, rate, rate, volatility, 100, False)
-                
-                prices.append(pricer_temp.price())
-                deltas.append(pricer_temp.delta(s))
+                    # Toujours utiliser une option européenne pour la sensibilité
+                    payoff_temp = opc.create_payoff(opc.PayoffStyle.European, opt_type_enum, strike)
+                    option_temp = opc.Option(maturity, payoff_temp)
+                    
+                    if pricing_method == "BlackScholes":
+                        pricer_temp = opc.BlackScholesPricer(option_temp, s, rate, rate, volatility)
+                    else:
+                        # Utiliser arbre binomial pour les autres méthodes
+                        pricer_temp = opc.BinomialTreePricer(option_temp, s, rate, rate, volatility, 100, False)
+                    
+                    prices.append(pricer_temp.price())
+                    deltas.append(pricer_temp.delta(s))
                 
                 # Valeur intrinsèque
                 if option_type == "Call":
@@ -8,9 +8,18 @@
 #include "option.hpp"
 #include "pricer.hpp"
 #include "black_scholes_pricer.hpp"
+#include "mc_accumulator.hpp"
 #include "monte_carlo_pricer.hpp"
+#include "path_store.hpp"
 #include "binomial_tree_pricer.hpp"
+#include "trinomial_barrier_pricer.hpp"
+#include "path_dependent_tree_pricer.hpp"
+#include "two_asset_tree_pricer.hpp"
+#include "adi_pricer.hpp"
 #include "finite_difference_pricer.hpp"
+#include "dupire_pricer.hpp"
+#include "exercise_boundary.hpp"
+#include "dividend_schedule.hpp"
 #include "replication_strategy.hpp"
 
 namespace py = pybind11;
@@ -55,6 +64,30 @@ PYBIND11_MODULE(option_pricer_cpp, m) {
         .def("strike", &Payoff::strike,
              "Obtenir le strike");
 
+    // =========================================================
+    // CLASS : TwoAssetPayoff
+    // =========================================================
+    py::class_<TwoAssetPayoff> two_asset(m, "TwoAssetPayoff");
+
+    py::enum_<TwoAssetPayoff::Style>(two_asset, "Style")
+        .value("Exchange", TwoAssetPayoff::Style::Exchange)
+        .value("Spread", TwoAssetPayoff::Style::Spread)
+        .value("BestOf", TwoAssetPayoff::Style::BestOf)
+        .value("WorstOf", TwoAssetPayoff::Style::WorstOf)
+        .export_values();
+
+    two_asset
+        .def(py::init<TwoAssetPayoff::Style, OptionType, double>(),
+             py::arg("style"),
+             py::arg("type"),
+             py::arg("strike") = 0.0,
+             "Payoff sur deux sous-jacents (échange, spread, best-of, worst-of)")
+        .def("__call__", &TwoAssetPayoff::operator(),
+             py::arg("spot1"), py::arg("spot2"))
+        .def("style", &TwoAssetPayoff::style)
+        .def("type", &TwoAssetPayoff::type)
+        .def("strike", &TwoAssetPayoff::strike);
+
     // =========================================================
     // FACTORY : PayoffFactory - SIGNATURE CORRECTE (4 params)
     // =========================================================
@@ -152,7 +185,74 @@ PYBIND11_MODULE(option_pricer_cpp, m) {
         .def_readwrite("ci_lower_95", &MCResult::ci_lower_95,
                        "Borne inférieure IC 95%")
         .def_readwrite("ci_upper_95", &MCResult::ci_upper_95,
-                       "Borne supérieure IC 95%");
+                       "Borne supérieure IC 95%")
+        .def_readwrite("paths", &MCResult::paths,
+                       "Nombre de paths simulés")
+        .def_readwrite("naive_std_error", &MCResult::naive_std_error,
+                       "Erreur standard d'un MC naïf de même taille")
+        .def_readwrite("variance_reduction", &MCResult::variance_reduction,
+                       "Facteur de réduction de variance");
+
+    // =========================================================
+    // CLASS : MCAccumulator
+    // =========================================================
+    py::class_<MCAccumulator>(m, "MCAccumulator")
+        .def(py::init<>())
+        .def("merge", &MCAccumulator::merge,
+             py::arg("other"),
+             "Fusionner avec un accumulateur du même run (lots disjoints)")
+        .def("results", &MCAccumulator::results,
+             "Résultats (prix, erreur standard, IC) par payoff")
+        .def("count", &MCAccumulator::count,
+             "Nombre total de paths accumulés")
+        .def("batch_count", &MCAccumulator::batch_count,
+             "Nombre de lots accumulés")
+        .def("is_complete", &MCAccumulator::is_complete,
+             "Vrai si tous les lots du run sont présents")
+        .def("to_string", &MCAccumulator::to_string,
+             "Sérialiser l'accumulateur (exact)")
+        .def_static("from_string", &MCAccumulator::from_string,
+             py::arg("text"),
+             "Relire un accumulateur sérialisé")
+        .def("save", &MCAccumulator::save,
+             py::arg("filename"),
+             "Sauvegarder l'accumulateur dans un fichier")
+        .def_static("load", &MCAccumulator::load,
+             py::arg("filename"),
+             "Charger un accumulateur depuis un fichier");
+
+    // =========================================================
+    // STRUCT : MCPrecisionReport
+    // =========================================================
+    py::class_<MCPrecisionReport>(m, "MCPrecisionReport")
+        .def(py::init<>())
+        .def_readwrite("price_double", &MCPrecisionReport::price_double,
+                       "Prix avec état des paths en double")
+        .def_readwrite("price_single", &MCPrecisionReport::price_single,
+                       "Prix avec état des paths en float")
+        .def_readwrite("difference", &MCPrecisionReport::difference,
+                       "Écart float - double")
+        .def_readwrite("std_error", &MCPrecisionReport::std_error,
+                       "Erreur standard MC")
+        .def_readwrite("difference_in_std_errors", &MCPrecisionReport::difference_in_std_errors,
+                       "Écart rapporté à l'erreur standard");
+
+    // =========================================================
+    // ENUM : MCPrecision (Monte Carlo)
+    // =========================================================
+    py::enum_<MonteCarloPricer::Precision>(m, "MCPrecision")
+        .value("Double", MonteCarloPricer::Precision::Double)
+        .value("Single", MonteCarloPricer::Precision::Single)
+        .export_values();
+
+    // =========================================================
+    // ENUM : SamplingScheme (Monte Carlo)
+    // =========================================================
+    py::enum_<MonteCarloPricer::SamplingScheme>(m, "SamplingScheme")
+        .value("Standard", MonteCarloPricer::SamplingScheme::Standard)
+        .value("Stratified", MonteCarloPricer::SamplingScheme::Stratified)
+        .value("LatinHypercube", MonteCarloPricer::SamplingScheme::LatinHypercube)
+        .export_values();
 
     // =========================================================
     // CLASS : MonteCarloPricer
@@ -186,7 +286,77 @@ PYBIND11_MODULE(option_pricer_cpp, m) {
         .def("price_with_confidence", &MonteCarloPricer::price_with_confidence,
              "Calculer le prix avec intervalle de confiance")
         .def("delta_pathwise", &MonteCarloPricer::delta_pathwise,
-             "Calculer le delta par méthode pathwise");
+             "Calculer le delta par méthode pathwise")
+        .def("enable_importance_sampling", &MonteCarloPricer::enable_importance_sampling,
+             py::arg("drift_shift"),
+             "Activer l'importance sampling avec un shift de drift donné")
+        .def("enable_importance_sampling_auto", &MonteCarloPricer::enable_importance_sampling_auto,
+             py::arg("pilot_paths") = 1000,
+             "Activer l'importance sampling avec shift optimal (pré-passe pilote)")
+        .def("disable_importance_sampling", &MonteCarloPricer::disable_importance_sampling,
+             "Désactiver l'importance sampling")
+        .def("importance_shift", &MonteCarloPricer::importance_shift,
+             "Shift de drift effectivement utilisé")
+        .def("set_sampling_scheme", &MonteCarloPricer::set_sampling_scheme,
+             py::arg("scheme"),
+             "Choisir le schéma d'échantillonnage (Standard, Stratified, LatinHypercube)")
+        .def("sampling_scheme", &MonteCarloPricer::sampling_scheme,
+             "Schéma d'échantillonnage courant")
+        .def("set_moment_matching", &MonteCarloPricer::set_moment_matching,
+             py::arg("enabled"),
+             "Activer le moment matching des tirages normaux")
+        .def("price_portfolio", &MonteCarloPricer::price_portfolio,
+             py::arg("options"),
+             "Pricer une liste d'options (même maturité) sur un seul jeu de paths")
+        .def("set_batch_count", &MonteCarloPricer::set_batch_count,
+             py::arg("batches"),
+             "Nombre de lots (sous-flux RNG) du moteur par lots")
+        .def("batch_count", &MonteCarloPricer::batch_count,
+             "Nombre de lots du moteur par lots")
+        .def("run_shard", &MonteCarloPricer::run_shard,
+             py::arg("shard"),
+             py::arg("shard_count"),
+             "Calculer une partie du run (lots k % shard_count == shard)")
+        .def("price_sharded", &MonteCarloPricer::price_sharded,
+             py::arg("workers"),
+             "Run réparti sur plusieurs processus puis fusionné")
+        .def("set_precision", &MonteCarloPricer::set_precision,
+             py::arg("precision"),
+             "Précision de l'état des paths (Double ou Single)")
+        .def("precision", &MonteCarloPricer::precision,
+             "Précision courante du moteur de paths")
+        .def("validate_precision", &MonteCarloPricer::validate_precision,
+             "Comparer les prix float et double à l'erreur standard MC")
+        .def("write_path_store", &MonteCarloPricer::write_path_store,
+             py::arg("filename"),
+             "Écrire les paths simulés dans un fichier binaire (rejouable)");
+
+    // =========================================================
+    // CLASS : PathStore
+    // =========================================================
+    py::class_<PathStore>(m, "PathStore")
+        .def(py::init<const std::string&>(),
+             py::arg("filename"),
+             "Ouvrir (mmap) un fichier de paths écrit par write_path_store")
+        .def("paths", &PathStore::paths,
+             "Nombre de paths stockés")
+        .def("steps", &PathStore::steps,
+             "Nombre de pas de temps")
+        .def("maturity", &PathStore::maturity,
+             "Maturité de la grille stockée")
+        .def("weight", &PathStore::weight,
+             py::arg("i"),
+             "Poids de vraisemblance du path i")
+        .def("path", [](const PathStore& store, std::size_t i) {
+                std::vector<double> out;
+                store.path(i, out);
+                return out;
+             },
+             py::arg("i"),
+             "Copie du path i")
+        .def("price", &PathStore::price,
+             py::arg("options"),
+             "Rejouer les paths stockés pour une liste d'options");
 
     // =========================================================
     // ENUM : TreeType
@@ -194,14 +364,90 @@ PYBIND11_MODULE(option_pricer_cpp, m) {
     py::enum_<BinomialTreePricer::TreeType>(m, "TreeType")
         .value("CoxRossRubinstein", BinomialTreePricer::TreeType::CoxRossRubinstein)
         .value("JarrowRudd", BinomialTreePricer::TreeType::JarrowRudd)
+        .value("LeisenReimer", BinomialTreePricer::TreeType::LeisenReimer)
+        .export_values();
+
+    // =========================================================
+    // ENUM : TreeSmoothing
+    // =========================================================
+    py::enum_<BinomialTreePricer::Smoothing>(m, "TreeSmoothing")
+        .value("NoSmoothing", BinomialTreePricer::Smoothing::None)
+        .value("BlackScholes", BinomialTreePricer::Smoothing::BlackScholes)
+        .value("BlackScholesRichardson", BinomialTreePricer::Smoothing::BlackScholesRichardson)
         .export_values();
 
+    // =========================================================
+    // STRUCT : TreeGreeks
+    // =========================================================
+    py::class_<TreeGreeks>(m, "TreeGreeks")
+        .def(py::init<>())
+        .def_readwrite("price", &TreeGreeks::price, "Prix")
+        .def_readwrite("delta", &TreeGreeks::delta, "Delta (nœuds du pas 1)")
+        .def_readwrite("gamma", &TreeGreeks::gamma, "Gamma (nœuds du pas 2)")
+        .def_readwrite("theta", &TreeGreeks::theta, "Theta (racine et pas 2)");
+
+    // =========================================================
+    // CLASS : ExerciseBoundary
+    // =========================================================
+    py::class_<ExerciseBoundary>(m, "ExerciseBoundary")
+        .def(py::init<OptionType, double, double, double, double,
+                      std::vector<double>, std::vector<double>>(),
+             py::arg("type"),
+             py::arg("strike"),
+             py::arg("rate"),
+             py::arg("carry"),
+             py::arg("volatility"),
+             py::arg("tau"),
+             py::arg("spots"),
+             "Frontière d'exercice S*(tau) (tau croissant, 0 = maturité)")
+        .def("type", &ExerciseBoundary::type)
+        .def("strike", &ExerciseBoundary::strike)
+        .def("maturity", &ExerciseBoundary::maturity)
+        .def("times_to_maturity", &ExerciseBoundary::times_to_maturity)
+        .def("critical_spots", &ExerciseBoundary::critical_spots)
+        .def("critical_spot", &ExerciseBoundary::critical_spot,
+             py::arg("tau"),
+             "Spot critique au temps restant tau (interpolation linéaire)")
+        .def("refine", &ExerciseBoundary::refine,
+             py::arg("iterations") = 6,
+             "Remplace les points relevés par la solution de l'équation intégrale de la frontière")
+        .def("is_exercise", &ExerciseBoundary::is_exercise,
+             py::arg("spot"), py::arg("tau"),
+             "Vrai si l'exercice immédiat est optimal")
+        .def("price", py::overload_cast<double>(&ExerciseBoundary::price, py::const_),
+             py::arg("spot"),
+             "Prix américain par l'intégrale de prime d'exercice anticipé")
+        .def("price", py::overload_cast<double, double>(&ExerciseBoundary::price, py::const_),
+             py::arg("spot"), py::arg("tau"),
+             "Prix américain au temps restant tau");
+
+    // =========================================================
+    // CLASS : CashDividend / DividendSchedule
+    // =========================================================
+    py::class_<CashDividend>(m, "CashDividend")
+        .def(py::init([](double time, double amount) { return CashDividend{time, amount}; }),
+             py::arg("time"), py::arg("amount"))
+        .def_readwrite("time", &CashDividend::time, "Date ex (années)")
+        .def_readwrite("amount", &CashDividend::amount, "Montant en cash");
+
+    py::class_<DividendSchedule>(m, "DividendSchedule")
+        .def(py::init<>())
+        .def(py::init<std::vector<CashDividend>>(),
+             py::arg("dividends"),
+             "Échéancier de dividendes discrets (trié par date ex)")
+        .def("empty", &DividendSchedule::empty)
+        .def("dividends", &DividendSchedule::dividends)
+        .def("present_value", &DividendSchedule::present_value,
+             py::arg("t"), py::arg("maturity"), py::arg("rate"),
+             "Valeur en t des dividendes de date ex dans [t, maturity)");
+
     // =========================================================
     // CLASS : BinomialTreePricer
     // =========================================================
     py::class_<BinomialTreePricer, Pricer, std::shared_ptr<BinomialTreePricer>>(m, "BinomialTreePricer")
         .def(py::init<const Option&, double, double, double, double,
-                      std::size_t, bool, BinomialTreePricer::TreeType>(),
+                      std::size_t, bool, BinomialTreePricer::TreeType,
+                      BinomialTreePricer::Smoothing>(),
              py::arg("option"),
              py::arg("spot"),
              py::arg("rate"),
@@ -210,6 +456,7 @@ PYBIND11_MODULE(option_pricer_cpp, m) {
              py::arg("steps"),
              py::arg("is_american") = false,
              py::arg("tree_type") = BinomialTreePricer::TreeType::CoxRossRubinstein,
+             py::arg("smoothing") = BinomialTreePricer::Smoothing::None,
              "Créer un pricer par arbre binomial\n\n"
              "Args:\n"
              "    option: Option à pricer\n"
@@ -219,17 +466,309 @@ PYBIND11_MODULE(option_pricer_cpp, m) {
              "    volatility: Volatilité\n"
              "    steps: Nombre de pas de l'arbre\n"
              "    is_american: True pour option américaine\n"
-             "    tree_type: Type d'arbre (CRR, JR)")
+             "    tree_type: Type d'arbre (CRR, JR, LR)\n"
+             "    smoothing: Lissage du dernier pas (BBS, BBSR)")
         .def("price", &BinomialTreePricer::price)
         .def("delta", &BinomialTreePricer::delta)
         .def("gamma", &BinomialTreePricer::gamma)
         .def("theta", &BinomialTreePricer::theta)
+        .def("price_and_greeks", &BinomialTreePricer::price_and_greeks,
+             "Prix, delta, gamma et theta d'un seul arbre")
+        .def("exercise_boundary", &BinomialTreePricer::exercise_boundary,
+             "Frontière d'exercice relevée pendant la remontée (américain)")
+        .def("price_chain", &BinomialTreePricer::price_chain,
+             py::arg("options"),
+             "Prix et Greeks d'une chaîne d'options (même maturité) sur un seul treillis")
+        .def("set_extended_tree", &BinomialTreePricer::set_extended_tree,
+             py::arg("enabled"),
+             "Démarrer l'arbre deux pas avant t = 0 (Greeks centrés)")
+        .def("extended_tree", &BinomialTreePricer::extended_tree)
+        .def("set_truncation", &BinomialTreePricer::set_truncation,
+             py::arg("width"),
+             "Ne remonter que les nœuds à ±width écarts-types (0 : désactivé, sinon >= 3)")
+        .def("truncation", &BinomialTreePricer::truncation)
+        .def("set_dividends", &BinomialTreePricer::set_dividends,
+             py::arg("dividends"),
+             "Dividendes discrets (spot diminué de la valeur des dividendes à venir)")
+        .def("dividends", &BinomialTreePricer::dividends)
+        .def("set_threads", &BinomialTreePricer::set_threads,
+             py::arg("threads"),
+             "Threads de la remontée pour les grands arbres (0 : tous les cœurs)")
+        .def("threads", &BinomialTreePricer::threads)
         .def("get_up_factor", &BinomialTreePricer::get_up_factor,
              "Obtenir le facteur de montée (u)")
         .def("get_down_factor", &BinomialTreePricer::get_down_factor,
              "Obtenir le facteur de descente (d)")
         .def("get_risk_neutral_prob", &BinomialTreePricer::get_risk_neutral_prob,
-             "Obtenir la probabilité risque-neutre (p)");
+             "Obtenir la probabilité risque-neutre (p)")
+        .def("get_steps", &BinomialTreePricer::get_steps,
+             "Nombre de pas effectif (impair pour Leisen-Reimer)");
+
+    // =========================================================
+    // CLASS : PathDependentTreePricer
+    // =========================================================
+    py::class_<PathDependentTreePricer, Pricer, std::shared_ptr<PathDependentTreePricer>>(m, "PathDependentTreePricer")
+        .def(py::init<const Option&, double, double, double, double,
+                      std::size_t, bool, std::size_t>(),
+             py::arg("option"),
+             py::arg("spot"),
+             py::arg("rate"),
+             py::arg("carry"),
+             py::arg("volatility"),
+             py::arg("steps"),
+             py::arg("is_american") = false,
+             py::arg("resolution") = 4,
+             "Créer un pricer par arbre pour options asiatiques et lookback\n\n"
+             "Args:\n"
+             "    option: Option asiatique ou lookback à pricer\n"
+             "    spot: Prix spot\n"
+             "    rate: Taux sans risque\n"
+             "    carry: Coût de portage\n"
+             "    volatility: Volatilité\n"
+             "    steps: Nombre de pas (dates de la moyenne, S0 compris : steps + 1)\n"
+             "    is_american: True pour exercice américain\n"
+             "    resolution: Points de la grille de moyenne / extrême par pas log(u)")
+        .def("price", &PathDependentTreePricer::price)
+        .def("delta", &PathDependentTreePricer::delta)
+        .def("gamma", &PathDependentTreePricer::gamma)
+        .def("get_steps", &PathDependentTreePricer::get_steps)
+        .def("get_resolution", &PathDependentTreePricer::get_resolution);
+
+    // =========================================================
+    // CLASS : TwoAssetTreePricer
+    // =========================================================
+    py::class_<TwoAssetTreePricer, Pricer, std::shared_ptr<TwoAssetTreePricer>> two_asset_tree(m, "TwoAssetTreePricer");
+
+    py::enum_<TwoAssetTreePricer::Exercise>(two_asset_tree, "Exercise")
+        .value("European", TwoAssetTreePricer::Exercise::European)
+        .value("American", TwoAssetTreePricer::Exercise::American)
+        .value("Bermudan", TwoAssetTreePricer::Exercise::Bermudan)
+        .export_values();
+
+    two_asset_tree
+        .def(py::init<const TwoAssetPayoff&, double, double, double, double, double, double,
+                      double, double, double, std::size_t, TwoAssetTreePricer::Exercise, std::size_t>(),
+             py::arg("payoff"),
+             py::arg("maturity"),
+             py::arg("spot1"),
+             py::arg("spot2"),
+             py::arg("rate"),
+             py::arg("carry1"),
+             py::arg("carry2"),
+             py::arg("volatility1"),
+             py::arg("volatility2"),
+             py::arg("correlation"),
+             py::arg("steps"),
+             py::arg("exercise") = TwoAssetTreePricer::Exercise::European,
+             py::arg("exercise_dates") = 0,
+             "Créer un pricer par arbre à deux sous-jacents (Boyle-Evnine-Gibbs)\n\n"
+             "Args:\n"
+             "    payoff: Payoff sur deux sous-jacents\n"
+             "    maturity: Maturité en années\n"
+             "    spot1, spot2: Prix spot\n"
+             "    rate: Taux sans risque\n"
+             "    carry1, carry2: Coûts de portage\n"
+             "    volatility1, volatility2: Volatilités\n"
+             "    correlation: Corrélation des log-rendements\n"
+             "    steps: Nombre de pas de l'arbre\n"
+             "    exercise: European, American ou Bermudan\n"
+             "    exercise_dates: Nombre de dates d'exercice (Bermudan)")
+        .def("price", &TwoAssetTreePricer::price)
+        .def("delta", &TwoAssetTreePricer::delta,
+             py::arg("spot"),
+             "Delta par rapport au premier sous-jacent")
+        .def("delta2", &TwoAssetTreePricer::delta2,
+             "Delta par rapport au second sous-jacent")
+        .def("set_threads", &TwoAssetTreePricer::set_threads,
+             py::arg("threads"),
+             "Threads de la remontée pour les grands pas (0 : tous les cœurs)")
+        .def("threads", &TwoAssetTreePricer::threads)
+        .def("get_steps", &TwoAssetTreePricer::get_steps);
+
+    // =========================================================
+    // CLASS : AdiPricer (EDP 2D, base de Heston et deux sous-jacents)
+    // =========================================================
+    py::class_<AdiPricer, Pricer, std::shared_ptr<AdiPricer>> adi(m, "AdiPricer");
+
+    py::enum_<AdiPricer::Scheme>(adi, "Scheme")
+        .value("Douglas", AdiPricer::Scheme::Douglas)
+        .value("CraigSneyd", AdiPricer::Scheme::CraigSneyd)
+        .value("HundsdorferVerwer", AdiPricer::Scheme::HundsdorferVerwer)
+        .export_values();
+
+    adi
+        .def("price", &AdiPricer::price)
+        .def("delta", &AdiPricer::delta,
+             py::arg("spot"),
+             "Delta par rapport à la première variable (grille en cache)")
+        .def("gamma", &AdiPricer::gamma,
+             py::arg("spot"),
+             "Gamma par rapport à la première variable (grille en cache)")
+        .def("set_scheme", &AdiPricer::set_scheme,
+             py::arg("scheme"),
+             py::arg("theta") = 0.0,
+             "Schéma ADI (theta <= 0 : valeur par défaut du schéma)")
+        .def("scheme", &AdiPricer::scheme)
+        .def("set_damping_steps", &AdiPricer::set_damping_steps,
+             py::arg("steps"),
+             "Pas de démarrage remplacés par deux demi-pas de Douglas implicites")
+        .def("damping_steps", &AdiPricer::damping_steps)
+        .def("set_threads", &AdiPricer::set_threads,
+             py::arg("threads"),
+             "Threads des solves par ligne et par colonne (0 : tous les cœurs)")
+        .def("threads", &AdiPricer::threads)
+        .def("get_steps", &AdiPricer::get_steps);
+
+    // =========================================================
+    // CLASS : HestonAdiPricer
+    // =========================================================
+    py::class_<HestonAdiPricer, AdiPricer, std::shared_ptr<HestonAdiPricer>>(m, "HestonAdiPricer")
+        .def(py::init<const Option&, double, double, double, double, double, double, double, double,
+                      std::size_t, std::size_t, std::size_t, bool>(),
+             py::arg("option"),
+             py::arg("spot"),
+             py::arg("rate"),
+             py::arg("carry"),
+             py::arg("variance"),
+             py::arg("mean_reversion"),
+             py::arg("long_variance"),
+             py::arg("vol_of_vol"),
+             py::arg("correlation"),
+             py::arg("spot_points") = 200,
+             py::arg("variance_points") = 100,
+             py::arg("steps") = 50,
+             py::arg("is_american") = false,
+             "Créer un pricer Heston par EDP ADI (S x v)\n\n"
+             "Args:\n"
+             "    option: Option vanille à pricer\n"
+             "    spot: Prix spot\n"
+             "    rate: Taux sans risque\n"
+             "    carry: Coût de portage\n"
+             "    variance: Variance initiale v0\n"
+             "    mean_reversion: Vitesse de retour kappa\n"
+             "    long_variance: Variance long terme theta\n"
+             "    vol_of_vol: Volatilité de la variance xi\n"
+             "    correlation: Corrélation spot / variance\n"
+             "    spot_points, variance_points: Intervalles de la grille\n"
+             "    steps: Pas de temps\n"
+             "    is_american: Exercice américain")
+        .def("variance_delta", &HestonAdiPricer::variance_delta,
+             "dV/dv0")
+        .def("vega", &HestonAdiPricer::vega,
+             "Vega par rapport à la volatilité initiale sqrt(v0)");
+
+    // =========================================================
+    // CLASS : TwoAssetAdiPricer
+    // =========================================================
+    py::class_<TwoAssetAdiPricer, AdiPricer, std::shared_ptr<TwoAssetAdiPricer>>(m, "TwoAssetAdiPricer")
+        .def(py::init<const TwoAssetPayoff&, double, double, double, double, double, double,
+                      double, double, double, std::size_t, std::size_t, std::size_t, bool>(),
+             py::arg("payoff"),
+             py::arg("maturity"),
+             py::arg("spot1"),
+             py::arg("spot2"),
+             py::arg("rate"),
+             py::arg("carry1"),
+             py::arg("carry2"),
+             py::arg("volatility1"),
+             py::arg("volatility2"),
+             py::arg("correlation"),
+             py::arg("points1") = 200,
+             py::arg("points2") = 200,
+             py::arg("steps") = 50,
+             py::arg("is_american") = false,
+             "Créer un pricer à deux sous-jacents par EDP ADI (S1 x S2)\n\n"
+             "Args:\n"
+             "    payoff: Payoff sur deux sous-jacents\n"
+             "    maturity: Maturité en années\n"
+             "    spot1, spot2: Prix spot\n"
+             "    rate: Taux sans risque\n"
+             "    carry1, carry2: Coûts de portage\n"
+             "    volatility1, volatility2: Volatilités\n"
+             "    correlation: Corrélation des log-rendements\n"
+             "    points1, points2: Intervalles de la grille\n"
+             "    steps: Pas de temps\n"
+             "    is_american: Exercice américain")
+        .def("delta2", &TwoAssetAdiPricer::delta2,
+             "Delta par rapport au second sous-jacent");
+
+    // =========================================================
+    // CLASS : LocalVolatilitySurface, PriceSurface, DupirePricer
+    // =========================================================
+    py::class_<LocalVolatilitySurface>(m, "LocalVolatilitySurface")
+        .def(py::init<double>(),
+             py::arg("volatility"),
+             "Volatilité constante")
+        .def(py::init<std::vector<double>, std::vector<double>, std::vector<std::vector<double>>>(),
+             py::arg("strikes"),
+             py::arg("times"),
+             py::arg("volatilities"),
+             "Volatilité locale tabulée : volatilities[j][i] au temps j, strike i (bilinéaire, plate au-delà)")
+        .def("__call__", &LocalVolatilitySurface::operator(),
+             py::arg("strike"), py::arg("time"))
+        .def("max_volatility", &LocalVolatilitySurface::max_volatility)
+        .def("strikes", &LocalVolatilitySurface::strikes)
+        .def("times", &LocalVolatilitySurface::times);
+
+    py::class_<PriceSurface>(m, "PriceSurface")
+        .def(py::init<>())
+        .def_readwrite("strikes", &PriceSurface::strikes)
+        .def_readwrite("maturities", &PriceSurface::maturities)
+        .def_readwrite("prices", &PriceSurface::prices, "prices[j][i] : maturité j, strike i");
+
+    py::class_<DupirePricer>(m, "DupirePricer")
+        .def(py::init<double, double, double, const LocalVolatilitySurface&, std::size_t, std::size_t>(),
+             py::arg("spot"),
+             py::arg("rate"),
+             py::arg("carry"),
+             py::arg("volatility"),
+             py::arg("strike_points") = 400,
+             py::arg("steps") = 200,
+             "Créer un pricer par l'EDP forward de Dupire (calls en fonction de K et T)\n\n"
+             "Args:\n"
+             "    spot: Prix spot\n"
+             "    rate: Taux sans risque\n"
+             "    carry: Coût de portage\n"
+             "    volatility: Volatilité locale sigma(K, T)\n"
+             "    strike_points: Intervalles de la grille en strike\n"
+             "    steps: Pas de temps jusqu'à la plus longue maturité")
+        .def("price_surface", &DupirePricer::price_surface,
+             py::arg("strikes"),
+             py::arg("maturities"),
+             py::arg("type") = OptionType::Call,
+             "Prix européens de tous les strikes x maturités (croissantes) en une résolution")
+        .def("volatility", &DupirePricer::volatility);
+
+    // =========================================================
+    // CLASS : TrinomialBarrierPricer
+    // =========================================================
+    py::class_<TrinomialBarrierPricer, Pricer, std::shared_ptr<TrinomialBarrierPricer>>(m, "TrinomialBarrierPricer")
+        .def(py::init<const Option&, double, double, double, double,
+                      std::size_t, bool, std::size_t>(),
+             py::arg("option"),
+             py::arg("spot"),
+             py::arg("rate"),
+             py::arg("carry"),
+             py::arg("volatility"),
+             py::arg("steps"),
+             py::arg("is_american") = false,
+             py::arg("refinement_levels") = 2,
+             "Créer un pricer trinomial pour options barrières\n\n"
+             "Args:\n"
+             "    option: Option barrière à pricer\n"
+             "    spot: Prix spot\n"
+             "    rate: Taux sans risque\n"
+             "    carry: Coût de portage\n"
+             "    volatility: Volatilité\n"
+             "    steps: Nombre de pas du treillis grossier\n"
+             "    is_american: True pour option américaine\n"
+             "    refinement_levels: Niveaux de maillage adaptatif (barrière et strike)")
+        .def("price", &TrinomialBarrierPricer::price)
+        .def("delta", &TrinomialBarrierPricer::delta)
+        .def("get_steps", &TrinomialBarrierPricer::get_steps,
+             "Nombre de pas effectif (augmenté si le spot est proche de la barrière)")
+        .def("get_space_step", &TrinomialBarrierPricer::get_space_step,
+             "Espacement en log-spot du treillis grossier");
 
     // =========================================================
     // ENUM : Scheme (Finite Difference)
@@ -240,6 +779,37 @@ PYBIND11_MODULE(option_pricer_cpp, m) {
         .value("CrankNicolson", FiniteDifferenceAmericanPricer::Scheme::CrankNicolson)
         .export_values();
 
+    py::class_<GridGreeks>(m, "GridGreeks")
+        .def(py::init<>())
+        .def_readwrite("price", &GridGreeks::price, "Prix")
+        .def_readwrite("delta", &GridGreeks::delta, "Delta (spline sur la grille)")
+        .def_readwrite("gamma", &GridGreeks::gamma, "Gamma (spline sur la grille)")
+        .def_readwrite("theta", &GridGreeks::theta, "Theta (tranche t = dt)");
+
+    py::class_<PriceProfile>(m, "PriceProfile")
+        .def(py::init<>())
+        .def_readwrite("spots", &PriceProfile::spots)
+        .def_readwrite("prices", &PriceProfile::prices)
+        .def_readwrite("deltas", &PriceProfile::deltas)
+        .def_readwrite("gammas", &PriceProfile::gammas);
+
+    py::enum_<FiniteDifferenceAmericanPricer::Constraint>(m, "FDConstraint")
+        .value("Projection", FiniteDifferenceAmericanPricer::Constraint::Projection)
+        .value("BrennanSchwartz", FiniteDifferenceAmericanPricer::Constraint::BrennanSchwartz)
+        .value("PSOR", FiniteDifferenceAmericanPricer::Constraint::PSOR)
+        .value("PolicyIteration", FiniteDifferenceAmericanPricer::Constraint::PolicyIteration)
+        .export_values();
+
+    py::enum_<FiniteDifferenceAmericanPricer::Exercise>(m, "FDExercise")
+        .value("European", FiniteDifferenceAmericanPricer::Exercise::European)
+        .value("American", FiniteDifferenceAmericanPricer::Exercise::American)
+        .export_values();
+
+    py::enum_<FiniteDifferenceAmericanPricer::Grid>(m, "FDGrid")
+        .value("Uniform", FiniteDifferenceAmericanPricer::Grid::Uniform)
+        .value("LogSpot", FiniteDifferenceAmericanPricer::Grid::LogSpot)
+        .export_values();
+
     // =========================================================
     // CLASS : FiniteDifferenceAmericanPricer
     // =========================================================
@@ -257,7 +827,7 @@ PYBIND11_MODULE(option_pricer_cpp, m) {
              py::arg("scheme") = FiniteDifferenceAmericanPricer::Scheme::CrankNicolson,
              "Créer un pricer par différences finies\n\n"
              "Args:\n"
-             "    option: Option à pricer (américaine)\n"
+             "    option: Option à pricer (vanille ou barrière)\n"
              "    spot: Prix spot\n"
              "    rate: Taux sans risque\n"
              "    carry: Coût de portage\n"
@@ -266,5 +836,54 @@ PYBIND11_MODULE(option_pricer_cpp, m) {
              "    N: Nombre de points en temps\n"
              "    scheme: Schéma numérique (Explicit, Implicit, CrankNicolson)")
         .def("price", &FiniteDifferenceAmericanPricer::price)
-        .def("delta", &FiniteDifferenceAmericanPricer::delta);
+        .def("delta", &FiniteDifferenceAmericanPricer::delta)
+        .def("gamma", &FiniteDifferenceAmericanPricer::gamma)
+        .def("theta", &FiniteDifferenceAmericanPricer::theta)
+        .def("price_and_greeks", &FiniteDifferenceAmericanPricer::price_and_greeks,
+             "Prix, delta, gamma et theta d'une seule résolution")
+        .def("price_profile", &FiniteDifferenceAmericanPricer::price_profile,
+             py::arg("spots"),
+             "Prix, deltas et gammas à plusieurs spots sur la même résolution")
+        .def("exercise_boundary", &FiniteDifferenceAmericanPricer::exercise_boundary,
+             "Frontière d'exercice, un point par pas de temps de la grille")
+        .def("price_chain", &FiniteDifferenceAmericanPricer::price_chain,
+             py::arg("options"), py::arg("volatilities") = std::vector<double>(),
+             "Prix et Greeks d'une chaîne d'options (même maturité) sur la grille uniforme, résolues par blocs")
+        .def("set_dividends", &FiniteDifferenceAmericanPricer::set_dividends,
+             py::arg("dividends"),
+             "Dividendes discrets (condition de saut aux dates ex)")
+        .def("dividends", &FiniteDifferenceAmericanPricer::dividends)
+        .def("set_grid", &FiniteDifferenceAmericanPricer::set_grid,
+             py::arg("grid"), py::arg("concentration") = 0.5,
+             "Grille uniforme en S ou log-spot concentrée (sinh) sur le strike et le spot")
+        .def("grid", &FiniteDifferenceAmericanPricer::grid)
+        .def("concentration", &FiniteDifferenceAmericanPricer::concentration)
+        .def("set_constraint", &FiniteDifferenceAmericanPricer::set_constraint,
+             py::arg("constraint"),
+             "Contrainte américaine : projection, Brennan-Schwartz, PSOR ou itération de politique")
+        .def("constraint", &FiniteDifferenceAmericanPricer::constraint)
+        .def("set_rannacher_steps", &FiniteDifferenceAmericanPricer::set_rannacher_steps,
+             py::arg("steps"),
+             "Pas de démarrage implicites (Crank-Nicolson) après la maturité et les dates ex")
+        .def("rannacher_steps", &FiniteDifferenceAmericanPricer::rannacher_steps)
+        .def("set_exercise", &FiniteDifferenceAmericanPricer::set_exercise,
+             py::arg("exercise"),
+             "Exercice européen ou américain (défaut)")
+        .def("exercise", &FiniteDifferenceAmericanPricer::exercise)
+        .def("set_monitoring_dates", &FiniteDifferenceAmericanPricer::set_monitoring_dates,
+             py::arg("dates"),
+             "Dates de surveillance de la barrière (vide : surveillance continue)")
+        .def("monitoring_dates", &FiniteDifferenceAmericanPricer::monitoring_dates)
+        .def("set_rebate", &FiniteDifferenceAmericanPricer::set_rebate,
+             py::arg("rebate"),
+             "Rebate d'un knock-out, versé à la sortie")
+        .def("rebate", &FiniteDifferenceAmericanPricer::rebate)
+        .def("set_tolerance", &FiniteDifferenceAmericanPricer::set_tolerance,
+             py::arg("tolerance"),
+             "Erreur contrôlée : grilles doublées jusqu'à la tolérance sur le prix (0 : grille fixe)")
+        .def("tolerance", &FiniteDifferenceAmericanPricer::tolerance)
+        .def("error_estimate", &FiniteDifferenceAmericanPricer::error_estimate,
+             "Erreur estimée du prix (Richardson entre les deux dernières grilles)")
+        .def("space_points", &FiniteDifferenceAmericanPricer::space_points)
+        .def("time_steps", &FiniteDifferenceAmericanPricer::time_steps);
 }
\ No newline at end of file
@@ -3,6 +3,9 @@
 #include <algorithm>
 #include <stdexcept>
 #include <numbers>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
 
 /* =========================================================
    ARBRES BINOMIAUX - IMPLÉMENTATION
@@ -11,7 +14,8 @@
 BinomialTreePricer::BinomialTreePricer(const Option& option, double spot, double rate, double carry, double volatility,
                                        std::size_t steps,
                                        bool is_american,
-                                       TreeType type)
+                                       TreeType type,
+                                       Smoothing smoothing)
     : option_(option),
       S0_(spot),
       r_(rate),
@@ -20,6 +24,7 @@ BinomialTreePricer::BinomialTreePricer(const Option& option, double spot, double
       N_(steps),
       is_american_(is_american),
       type_(type),
+      smoothing_(smoothing),
       dt_(option.maturity() / static_cast<double>(steps)) // On convertit en double a cause de la division
 {
     // Validation
@@ -29,6 +34,8 @@ BinomialTreePricer::BinomialTreePricer(const Option& option, double spot, double
         throw std::invalid_argument("Volatility must be positive");
     if (steps == 0)
         throw std::invalid_argument("Number of steps must be positive");
+    if (smoothing != Smoothing::None && steps < 2)
+        throw std::invalid_argument("Black-Scholes smoothing needs at least 2 steps");
     
     // Calcul des paramètres selon le type d'arbre
     compute_tree_parameters();
@@ -44,6 +51,9 @@ void BinomialTreePricer::compute_tree_parameters()
     case TreeType::JarrowRudd:
         compute_jr_parameters();
         break;
+    case TreeType::LeisenReimer:
+        compute_lr_parameters();
+        break;
     default:
         throw std::runtime_error("Unknown tree type");
     }
@@ -83,114 +93,729 @@ void BinomialTreePricer::compute_jr_parameters()
     p_ = 0.5;
 }
 
+/* =========================================================
+   LEISEN-REIMER (LR)
+   ========================================================= */
+void BinomialTreePricer::compute_lr_parameters()
+{
+    // L'inversion de Peizer-Pratt suppose un nombre de pas impair
+    if (N_ % 2 == 0)
+    {
+        ++N_;
+        dt_ = option_.maturity() / static_cast<double>(N_);
+    }
+
+    double K = option_.payoff().strike();
+    if (K <= 0.0)
+        throw std::invalid_argument("Leisen-Reimer tree needs a positive strike");
+
+    double T = option_.maturity();
+    double n = static_cast<double>(N_);
+    double spot = S0_ - dividends_.present_value(0.0, T, r_);
+    double d1 = (std::log(spot / K) + (b_ + 0.5 * sigma_ * sigma_) * T) / (sigma_ * std::sqrt(T));
+    double d2 = d1 - sigma_ * std::sqrt(T);
+
+    double growth = std::exp(b_ * dt_);
+    double p_prime = peizer_pratt(d1, n);
+
+    p_ = peizer_pratt(d2, n);
+    u_ = growth * p_prime / p_;
+    d_ = (growth - p_ * u_) / (1.0 - p_);
+    df_ = std::exp(-r_ * dt_);
+}
+
+double BinomialTreePricer::peizer_pratt(double z, double n)
+{
+    double x = z / (n + 1.0 / 3.0 + 0.1 / (n + 1.0));
+    double root = std::sqrt(0.25 - 0.25 * std::exp(-x * x * (n + 1.0 / 6.0)));
+    return (z >= 0.0) ? 0.5 + root : 0.5 - root;
+}
+
 /* =========================================================
    ÉVALUATION DE L'ARBRE
    ========================================================= */
 double BinomialTreePricer::price() const
 {
-    return evaluate_tree();
+    return price_and_greeks().price;
+}
+
+void BinomialTreePricer::set_extended_tree(bool enabled)
+{
+    extended_ = enabled;
+    greeks_cached_ = false;
+}
+
+void BinomialTreePricer::set_dividends(const DividendSchedule& dividends)
+{
+    if (dividends.present_value(0.0, option_.maturity(), r_) >= S0_)
+        throw std::invalid_argument("Dividends exceed the spot value");
+
+    dividends_ = dividends;
+    greeks_cached_ = false;
+
+    // Leisen-Reimer : le treillis dépend du spot escompté
+    compute_tree_parameters();
+}
+
+void BinomialTreePricer::set_truncation(double width)
+{
+    if (width < 0.0 || (width > 0.0 && width < kMinTruncation))
+        throw std::invalid_argument("Truncation width must be 0 (disabled) or at least 3 standard deviations");
+
+    truncation_ = width;
+    greeks_cached_ = false;
 }
 
-double BinomialTreePricer::evaluate_tree() const
+TreeGreeks BinomialTreePricer::price_and_greeks() const
 {
+    if (greeks_cached_)
+        return cached_greeks_;
+
+    TreeGreeks result = evaluate_tree();
+
+    if (smoothing_ == Smoothing::BlackScholesRichardson)
+    {
+        // Richardson sur une erreur en 1/N : (N V(N) - M V(M)) / (N - M), M ≈ N/2
+        // (= 2 V(N) - V(N/2) pour N pair), les deux arbres lissés par BBS.
+        // Les Greeks sont linéaires en V : même combinaison
+        BinomialTreePricer half(option_, S0_, r_, b_, sigma_, std::max<std::size_t>(N_ / 2, 2),
+                                is_american_, type_, Smoothing::BlackScholes);
+        half.extended_ = extended_;
+        half.threads_ = threads_;
+        half.truncation_ = truncation_;
+        half.dividends_ = dividends_;
+        half.compute_tree_parameters();
+
+        double n = static_cast<double>(N_);
+        double m = static_cast<double>(half.N_);
+        if (m < n)
+        {
+            TreeGreeks coarse = half.evaluate_tree();
+            auto extrapolate = [&](double fine, double rough) { return (n * fine - m * rough) / (n - m); };
+
+            result.price = extrapolate(result.price, coarse.price);
+            result.delta = extrapolate(result.delta, coarse.delta);
+            result.gamma = extrapolate(result.gamma, coarse.gamma);
+            result.theta = extrapolate(result.theta, coarse.theta);
+        }
+    }
+
+    cached_greeks_ = result;
+    greeks_cached_ = true;
+    return result;
+}
+
+double BinomialTreePricer::black_scholes_value(const Payoff& payoff, double spot, double tau) const
+{
+    double K = payoff.strike();
+    double vol = sigma_ * std::sqrt(tau);
+    double df = std::exp(-r_ * tau);
+    double ff = std::exp((b_ - r_) * tau);
+
+    if (K <= 0.0)
+        return payoff.payoff_spot(spot * std::exp(b_ * tau)) * df;
+
+    double d1 = (std::log(spot / K) + (b_ + 0.5 * sigma_ * sigma_) * tau) / vol;
+    double d2 = d1 - vol;
+
+    auto N = [](double x) { return 0.5 * std::erfc(-x / std::sqrt(2.0)); };
+
+    if (payoff.type() == OptionType::Call)
+        return spot * ff * N(d1) - K * df * N(d2);
+    else
+        return K * df * N(-d2) - spot * ff * N(-d1);
+}
+
+TreeGreeks BinomialTreePricer::evaluate_tree() const
+{
+    Lattice lattice = build_lattice();
+    std::size_t total = lattice.total;
+    
     // Vecteur pour stocker les valeurs aux noeuds
-    std::vector<double> values(N_ + 1);
+    std::vector<double> values;
+    terminal_values(lattice, values);
+
+    // Grands arbres : remontée par tuiles (cache, threads) ou limitée à la
+    // bande de ±k écarts-types, jusqu'aux derniers pas
+    std::size_t n = (truncation_ > 0.0) ? induct_truncated(lattice, values, total, 3)
+                                        : induct_tiled(lattice, values, total, 2);
+
+    // Valeurs aux pas 1 et 2, conservées pour les Greeks
+    double step1[2] = {0.0, 0.0};
+    double step2[3] = {0.0, 0.0, 0.0};
     
-    // Condition terminale (payoff à maturité)
-    for (std::size_t i = 0; i <= N_; ++i)
+    // Remontée dans l'arbre (backward induction)
+    while (n-- > 0)
+    {
+        induct_range(lattice, values.data(), n, 0, n + 1);
+
+        if (n == 2)
+            std::copy(values.begin(), values.begin() + 3, step2);
+        else if (n == 1)
+            std::copy(values.begin(), values.begin() + 2, step1);
+    }
+
+    return read_greeks(lattice, step2, step1, values[0]);
+}
+
+void BinomialTreePricer::terminal_values(const Lattice& lattice, std::vector<double>& values) const
+{
+    std::size_t total = lattice.total;
+    values.resize(total + 1);
+
+    // Condition terminale (payoff à maturité ou valeur BS au dernier pas)
+    const double* grid = lattice.grid.data() + lattice.offset - total / 2;
+    for (std::size_t i = 0; i <= total; ++i)
     {
-        // Prix du sous-jacent au nœud (i, N)
-        double S = S0_ * std::pow(u_, static_cast<double>(i)) 
-                       * std::pow(d_, static_cast<double>(N_ - i));
+        // Prix du sous-jacent au nœud (i, total) : S* sur l'arbre, S* + dividendes restants en réel
+        double S = lattice.scale[total] * grid[i];
+        double spot = S + lattice.escrow[total];
         
-        values[i] = option_.payoff().payoff_spot(S);
+        if (smoothing_ == Smoothing::None)
+        {
+            values[i] = option_.payoff().payoff_spot(spot);
+        }
+        else
+        {
+            values[i] = black_scholes_value(option_.payoff(), S, dt_);
+            if (is_american_)
+                values[i] = std::max(values[i], option_.payoff().payoff_spot(spot));
+        }
     }
-    
-    // Remontée dans l'arbre (backward induction)
-    for (std::size_t n = N_; n-- > 0;)
+}
+
+TreeGreeks BinomialTreePricer::read_greeks(const Lattice& lattice,
+                                           const double* step2,
+                                           const double* step1,
+                                           double root_value) const
+{
+    double root = lattice.root;
+
+    // Sous-jacent aux nœuds du pas 2 (bas, milieu, haut)
+    double S_dd = root * d_ * d_;
+    double S_ud = root * u_ * d_;
+    double S_uu = root * u_ * u_;
+
+    // Gamma : différence seconde sur les trois nœuds du pas 2
+    double delta_up = (step2[2] - step2[1]) / (S_uu - S_ud);
+    double delta_down = (step2[1] - step2[0]) / (S_ud - S_dd);
+    double delta_mid = (step2[2] - step2[0]) / (S_uu - S_dd);
+
+    TreeGreeks greeks;
+    greeks.gamma = (delta_up - delta_down) / (0.5 * (S_uu - S_dd));
+
+    // Spot de l'arbre en t = 0 (S0 sans dividende)
+    double spot = lattice.spot;
+
+    if (lattice.extended)
+    {
+        // Le nœud central du pas 2 est (S0, t = 0)
+        greeks.price = step2[1];
+        greeks.delta = delta_mid;
+
+        // Theta entre la racine (t = -2Δt) et t = 0, ramenée au spot S0
+        double start = root_value + delta_mid * (spot - root);
+        greeks.theta = (step2[1] - start) / (2.0 * dt_);
+    }
+    else
     {
+        greeks.price = root_value;
+        greeks.delta = (step1[1] - step1[0]) / (spot * (u_ - d_));
+
+        // Theta entre t = 0 et t = 2Δt (S_ud = S0 pour CRR, corrigé par delta sinon)
+        double later = step2[1] + delta_mid * (spot - S_ud);
+        greeks.theta = (later - root_value) / (2.0 * dt_);
+    }
+
+    return greeks;
+}
+
+/* =========================================================
+   FRONTIÈRE D'EXERCICE ANTICIPÉ
+   ========================================================= */
+
+ExerciseBoundary BinomialTreePricer::exercise_boundary() const
+{
+    if (!is_american_)
+        throw std::invalid_argument("Exercise boundary requires an American tree");
+    if (!dividends_.empty())
+        throw std::invalid_argument("Exercise boundary assumes a continuous carry (no discrete dividends)");
+
+    Lattice lattice = build_lattice();
+    std::size_t total = lattice.total;
+    std::size_t shift = lattice.extended ? 2 : 0;
+    OptionType type = option_.payoff().type();
+    double T = option_.maturity();
+
+    std::vector<double> values;
+    terminal_values(lattice, values);
+
+    // Remontée pas à pas (sans tuiles) : S* relevé sur chaque tranche,
+    // de la maturité vers t = 0 (tau croissant). Avec lissage BBS, le
+    // dernier pas (tau = Δt) porte déjà les valeurs exercées
+    std::vector<double> tau(1, 0.0);
+    std::vector<double> critical(1, ExerciseBoundary::expiry_limit(type, lattice.strike, r_, b_));
+    std::vector<double> spots(total + 1);
+
+    for (std::size_t n = total + 1; n-- > shift;)
+    {
+        if (n < total)
+            induct_range(lattice, values.data(), n, 0, n + 1);
+        else if (smoothing_ == Smoothing::None)
+            continue;  // Maturité : limite analytique ci-dessus
+
+        const double* grid = lattice.grid.data() + lattice.offset - n / 2;
         for (std::size_t i = 0; i <= n; ++i)
+            spots[i] = lattice.scale[n] * grid[i];
+
+        tau.push_back(T - static_cast<double>(n - shift) * dt_);
+        critical.push_back(ExerciseBoundary::critical_from_slice(type, lattice.strike,
+                                                                 spots.data(), values.data(), n + 1));
+    }
+
+    return ExerciseBoundary(type, lattice.strike, r_, b_, sigma_, std::move(tau), std::move(critical));
+}
+
+/* =========================================================
+   CHAÎNE DE STRIKES SUR UN TREILLIS PARTAGÉ
+   ========================================================= */
+
+std::vector<TreeGreeks> BinomialTreePricer::price_chain(const std::vector<Option>& options) const
+{
+    if (options.empty())
+        throw std::invalid_argument("Chain must contain at least one option");
+    if (type_ == TreeType::LeisenReimer)
+        throw std::invalid_argument("Leisen-Reimer lattice depends on the strike: price each strike separately");
+
+    std::vector<const Payoff*> payoffs;
+    for (const auto& opt : options)
+    {
+        if (std::abs(opt.maturity() - option_.maturity()) > 1e-12)
+            throw std::invalid_argument("All options must share the tree maturity");
+        payoffs.push_back(&opt.payoff());
+    }
+
+    std::vector<TreeGreeks> result = evaluate_chain(payoffs);
+
+    if (smoothing_ == Smoothing::BlackScholesRichardson)
+    {
+        // Même extrapolation que price_and_greeks, option par option
+        BinomialTreePricer half(option_, S0_, r_, b_, sigma_, std::max<std::size_t>(N_ / 2, 2),
+                                is_american_, type_, Smoothing::BlackScholes);
+        half.extended_ = extended_;
+        half.dividends_ = dividends_;
+        half.compute_tree_parameters();
+
+        double n = static_cast<double>(N_);
+        double m = static_cast<double>(half.N_);
+        if (m < n)
         {
-            // Prix du sous-jacent au nœud (i, n)
-            double S = S0_ * std::pow(u_, static_cast<double>(i))
-                           * std::pow(d_, static_cast<double>(n - i));
-            
-            // Valeur de continuation (espérance actualisée)
-            double continuation = df_ * (p_ * values[i + 1] + (1.0 - p_) * values[i]);
-            
+            std::vector<TreeGreeks> coarse = half.evaluate_chain(payoffs);
+            auto extrapolate = [&](double fine, double rough) { return (n * fine - m * rough) / (n - m); };
+
+            for (std::size_t k = 0; k < result.size(); ++k)
+            {
+                result[k].price = extrapolate(result[k].price, coarse[k].price);
+                result[k].delta = extrapolate(result[k].delta, coarse[k].delta);
+                result[k].gamma = extrapolate(result[k].gamma, coarse[k].gamma);
+                result[k].theta = extrapolate(result[k].theta, coarse[k].theta);
+            }
+        }
+    }
+
+    return result;
+}
+
+std::vector<TreeGreeks> BinomialTreePricer::evaluate_chain(const std::vector<const Payoff*>& payoffs) const
+{
+    Lattice lattice = build_lattice();
+    std::size_t total = lattice.total;
+    std::size_t count = payoffs.size();
+
+    std::vector<double> strikes(count), phis(count);
+    for (std::size_t k = 0; k < count; ++k)
+    {
+        strikes[k] = payoffs[k]->strike();
+        phis[k] = (payoffs[k]->type() == OptionType::Call) ? 1.0 : -1.0;
+    }
+
+    // Valeurs entrelacées : values[i * count + k] = nœud i, option k.
+    // La mise à jour d'un nœud est une boucle contiguë sur les options
+    std::vector<double> values((total + 1) * count);
+
+    const double* grid = lattice.grid.data() + lattice.offset - total / 2;
+    for (std::size_t i = 0; i <= total; ++i)
+    {
+        double S = lattice.scale[total] * grid[i];
+        double spot = S + lattice.escrow[total];
+        for (std::size_t k = 0; k < count; ++k)
+        {
+            double& value = values[i * count + k];
+            if (smoothing_ == Smoothing::None)
+            {
+                value = payoffs[k]->payoff_spot(spot);
+            }
+            else
+            {
+                value = black_scholes_value(*payoffs[k], S, dt_);
+                if (is_american_)
+                    value = std::max(value, payoffs[k]->payoff_spot(spot));
+            }
+        }
+    }
+
+    double up = df_ * p_;
+    double down = df_ * (1.0 - p_);
+    const double* K = strikes.data();
+    const double* phi = phis.data();
+
+    std::vector<double> step1(2 * count), step2(3 * count);
+
+    for (std::size_t n = total; n-- > 0;)
+    {
+        grid = lattice.grid.data() + lattice.offset - n / 2;
+        double scale = lattice.scale[n];
+
+        for (std::size_t i = 0; i <= n; ++i)
+        {
+            double* node = values.data() + i * count;
+            const double* next = node + count;
+            double S = scale * grid[i] + lattice.escrow[n];
+
             if (is_american_)
             {
-                // Option américaine : max(continuation, exercice immédiat)
-                double exercise = option_.payoff().payoff_spot(S);
-                values[i] = std::max(continuation, exercise);
+                for (std::size_t k = 0; k < count; ++k)
+                {
+                    double continuation = up * next[k] + down * node[k];
+                    node[k] = std::max(continuation, std::max(phi[k] * (S - K[k]), 0.0));
+                }
             }
             else
             {
-                // Option européenne : continuation uniquement
-                values[i] = continuation;
+                for (std::size_t k = 0; k < count; ++k)
+                    node[k] = up * next[k] + down * node[k];
             }
         }
+
+        if (n == 2)
+            std::copy(values.begin(), values.begin() + 3 * count, step2.begin());
+        else if (n == 1)
+            std::copy(values.begin(), values.begin() + 2 * count, step1.begin());
     }
-    
-    // La valeur à la racine est le prix de l'option
-    return values[0];
+
+    std::vector<TreeGreeks> result(count);
+    for (std::size_t k = 0; k < count; ++k)
+    {
+        double s2[3] = {step2[k], step2[count + k], step2[2 * count + k]};
+        double s1[2] = {step1[k], step1[count + k]};
+        result[k] = read_greeks(lattice, s2, s1, values[k]);
+    }
+
+    return result;
 }
 
 /* =========================================================
-   GREEKS PAR ARBRES BINOMIAUX (ON UTILISE DES APPROXIMATIONS)
+   MOTEUR DE REMONTÉE (TABLES, TUILES, THREADS)
    ========================================================= */
 
-double BinomialTreePricer::delta(double spot) const
+BinomialTreePricer::Lattice BinomialTreePricer::build_lattice() const
 {
-    // Delta par différences finies : (V(S+h) - V(S-h)) / 2h
-    double h = 1e-4 * spot;
-    
-    BinomialTreePricer up(option_, spot + h, r_, b_, sigma_, N_, is_american_, type_);
-    BinomialTreePricer down(option_, spot - h, r_, b_, sigma_, N_, is_american_, type_);
-    
-    return (up.price() - down.price()) / (2.0 * h);
+    // Avec lissage BBS, l'arbre s'arrête au pas N-1 où l'on place
+    // la valeur Black-Scholes sur le dernier intervalle
+    std::size_t last = (smoothing_ == Smoothing::None) ? N_ : N_ - 1;
+
+    // Arbre étendu : deux pas de plus, racine à t = -2Δt en S0 / (u d).
+    // Un arbre trop court pour lire gamma est étendu automatiquement
+    bool extended = extended_ || last < 2;
+    std::size_t total = last + (extended ? 2 : 0);
+
+    // Dividendes discrets : l'arbre porte le spot diminué des dividendes à venir
+    double T = option_.maturity();
+    double spot = S0_ - dividends_.present_value(0.0, T, r_);
+    double root = extended ? spot / (u_ * d_) : spot;
+
+    // S(i, n) = root u^i d^(n-i) = root (u d)^(n/2) (u/d)^(i - n/2) : une table
+    // de puissances de u/d, lue de façon contiguë à chaque pas (pas de std::pow
+    // par nœud), et un facteur par pas (demi-puissance de u/d pour n impair)
+    Lattice lattice;
+    lattice.total = total;
+    lattice.offset = (total + 1) / 2;
+    lattice.root = root;
+    lattice.extended = extended;
+    lattice.strike = option_.payoff().strike();
+    lattice.phi = (option_.payoff().type() == OptionType::Call) ? 1.0 : -1.0;
+    lattice.spot = spot;
+
+    // Valeur au pas n des dividendes restants (t_n = (n - 2) Δt si étendu)
+    lattice.escrow.assign(total + 1, 0.0);
+    if (!dividends_.empty())
+    {
+        double shift = extended ? 2.0 : 0.0;
+        for (std::size_t n = 0; n <= total; ++n)
+            lattice.escrow[n] = dividends_.present_value((static_cast<double>(n) - shift) * dt_, T, r_);
+    }
+
+    double log_ratio = std::log(u_ / d_);
+    double log_product = std::log(u_ * d_);
+
+    lattice.grid.resize(lattice.offset + (total + 1) / 2 + 1);
+    for (std::size_t j = 0; j < lattice.grid.size(); ++j)
+        lattice.grid[j] = std::exp((static_cast<double>(j) - static_cast<double>(lattice.offset)) * log_ratio);
+
+    lattice.scale.resize(total + 1);
+    for (std::size_t n = 0; n <= total; ++n)
+        lattice.scale[n] = root * std::exp(0.5 * static_cast<double>(n) * log_product
+                                           - 0.5 * static_cast<double>(n % 2) * log_ratio);
+
+    return lattice;
 }
 
-double BinomialTreePricer::gamma(double spot) const
+template <bool American>
+void BinomialTreePricer::induct_range(const Lattice& lattice, double* values,
+                                      std::size_t n, std::size_t begin, std::size_t end) const
 {
-    // Gamma à partir de l'arbre directement
-    // Après un pas : on a 3 valeurs (haut, milieu, bas)
-    
-    if (N_ < 2)
+    const double* grid = lattice.grid.data() + lattice.offset - n / 2;
+    double scale = lattice.scale[n];
+    double up = df_ * p_;
+    double down = df_ * (1.0 - p_);
+    double K = lattice.strike - lattice.escrow[n];  // Exercice au spot réel S* + dividendes
+    double phi = lattice.phi;
+
+    // En place, nœuds croissants : values[i + 1] est encore au pas n + 1.
+    // Exercice sans branche (max), boucle vectorisable
+    for (std::size_t i = begin; i < end; ++i)
     {
-        // Fallback : différences finies
-        return Pricer::gamma(spot);
+        double continuation = up * values[i + 1] + down * values[i];
+        if constexpr (American)
+        {
+            double exercise = std::max(phi * (scale * grid[i] - K), 0.0);
+            values[i] = std::max(continuation, exercise);
+        }
+        else
+        {
+            values[i] = continuation;
+        }
     }
-    
-    // Valeurs après un pas
-    double S_u = spot * u_;
-    double S_d = spot * d_;
-    
-    // Construire des sous-arbres
-    BinomialTreePricer tree_u(option_, S_u, r_, b_, sigma_, N_-1, is_american_, type_);
-    BinomialTreePricer tree_d(option_, S_d, r_, b_, sigma_, N_-1, is_american_, type_);
-    
-    double V_u = tree_u.price();
-    double V_d = tree_d.price();
-    
-    // Delta vers le haut et vers le bas
-    double delta_u = (V_u - price()) / (S_u - spot);
-    double delta_d = (price() - V_d) / (spot - S_d);
-    
-    // Gamma
-    return (delta_u - delta_d) / (0.5 * (S_u - S_d));
+}
+
+void BinomialTreePricer::induct_range(const Lattice& lattice, double* values,
+                                      std::size_t n, std::size_t begin, std::size_t end) const
+{
+    if (is_american_)
+        induct_range<true>(lattice, values, n, begin, end);
+    else
+        induct_range<false>(lattice, values, n, begin, end);
+}
+
+double BinomialTreePricer::edge_value(const Lattice& lattice, std::size_t n, std::size_t i) const
+{
+    const double* grid = lattice.grid.data() + lattice.offset - n / 2;
+    double S = lattice.scale[n] * grid[i];
+    double shift = lattice.extended ? 2.0 : 0.0;
+    double tau = option_.maturity() - (static_cast<double>(n) - shift) * dt_;
+
+    // À k sigma sqrt(T) du spot et du strike : valeur européenne de
+    // Black-Scholes. Si américaine, loin dans la monnaie, la valeur est celle
+    // de l'exercice optimal : immédiat, ou juste après une date ex restante
+    // (valeur linéaire du forward, le dividende détaché est acquis au put)
+    double value = black_scholes_value(option_.payoff(), S, tau);
+    if (is_american_)
+    {
+        double exercise = lattice.phi * (S + lattice.escrow[n] - lattice.strike);
+        double t = option_.maturity() - tau;
+        double remaining = lattice.escrow[n];
+        for (const auto& dividend : dividends_.dividends())
+        {
+            if (dividend.time < t - 1e-12 || dividend.time >= option_.maturity())
+                continue;
+            double h = dividend.time - t;
+            remaining -= dividend.amount * std::exp(-r_ * h);
+            exercise = std::max(exercise, lattice.phi * (S * std::exp((b_ - r_) * h) + remaining
+                                                          - lattice.strike * std::exp(-r_ * h)));
+        }
+        value = std::max(value, std::max(exercise, 0.0));
+    }
+    return value;
+}
+
+std::size_t BinomialTreePricer::induct_truncated(const Lattice& lattice, std::vector<double>& values,
+                                                 std::size_t from, std::size_t to) const
+{
+    // Bande fixe en log S pour tous les pas : [min(S0, K), max(S0, K)]
+    // élargi de k sigma sqrt(T). Une bande de ±k écarts-types de chaque pas
+    // passe près de la monnaie sur les premiers pas, où la valeur de bord
+    // perd la valeur temps. Ici le bord est à k sigma sqrt(T) de la monnaie
+    // à tout instant. Marge de 2 nœuds : pas <= 3 complets pour les Greeks
+    if (from <= to)
+        return from;
+
+    double T = option_.maturity() + (lattice.extended ? 2.0 * dt_ : 0.0);
+    double x_spot = std::log(lattice.spot);
+    double x_strike = (lattice.strike > 0.0) ? std::log(lattice.strike) : x_spot;
+    double x_lo = std::min(x_spot, x_strike) - truncation_ * sigma_ * std::sqrt(T);
+    double x_hi = std::max(x_spot, x_strike) + truncation_ * sigma_ * std::sqrt(T);
+    double log_ratio = std::log(u_ / d_);
+
+    std::size_t lo = 0;
+    std::size_t hi = from;  // Nœuds définis du pas n + 1 : [lo, hi]
+
+    for (std::size_t n = from; n-- > to;)
+    {
+        // log S(i, n) = log scale[n] + (i - n / 2) log(u / d)
+        double nodes = static_cast<double>(n);
+        double centre = static_cast<double>(n / 2) - std::log(lattice.scale[n]) / log_ratio;
+        double first = std::ceil(centre + x_lo / log_ratio) - 2.0;
+        double last = std::floor(centre + x_hi / log_ratio) + 2.0;
+
+        // Bande du pas n, contenue dans les nœuds définis du pas n + 1
+        std::size_t begin = static_cast<std::size_t>(std::clamp(first, 0.0, nodes));
+        std::size_t end = static_cast<std::size_t>(std::clamp(last, 0.0, nodes));
+        begin = std::max(begin, lo);
+        end = std::min(end, hi - 1);
+
+        induct_range(lattice, values.data(), n, begin, end + 1);
+
+        lo = begin;
+        hi = end;
+        if (begin > 0)
+            values[--lo] = edge_value(lattice, n, begin - 1);
+        if (end < n)
+            values[++hi] = edge_value(lattice, n, end + 1);
+    }
+
+    return to;
+}
+
+std::size_t BinomialTreePricer::induct_tiled(const Lattice& lattice, std::vector<double>& values,
+                                             std::size_t from, std::size_t to) const
+{
+    const std::size_t W = kTileWidth;
+    const std::size_t H = kTileHeight;
+
+    // Un bloc de H pas n'est découpé que si le pas compte au moins deux tuiles
+    auto tiled = [&](std::size_t top) { return top + 1 >= 2 * W && top >= to + H; };
+    if (!tiled(from))
+        return from;
+
+    std::size_t workers = threads_ ? threads_ : std::max<std::size_t>(1, std::thread::hardware_concurrency());
+    workers = std::min(workers, (from + 1) / W);
+
+    // Nœud gauche de chaque tuile à chaque pas du bloc (raccord des triangles)
+    std::vector<double> left(((from + 1) / W) * H);
+    double* v = values.data();
+
+    // Barrière entre phases (mutex + génération)
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::size_t arrived = 0, generation = 0;
+    auto sync = [&]()
+    {
+        if (workers == 1)
+            return;
+        std::unique_lock<std::mutex> lock(mutex);
+        std::size_t current = generation;
+        if (++arrived == workers)
+        {
+            arrived = 0;
+            ++generation;
+            cv.notify_all();
+        }
+        else
+        {
+            cv.wait(lock, [&] { return generation != current; });
+        }
+    };
+
+    auto work = [&](std::size_t worker)
+    {
+        for (std::size_t top = from; tiled(top); top -= H)
+        {
+            // Tuiles [k W, (k + 1) W), la dernière va jusqu'au bord de l'arbre
+            std::size_t count = (top + 1) / W;
+
+            // Phase 1 : trapèzes. Sans le voisin de droite, la tuile [a, b)
+            // calcule [a, b - s) au s-ième pas du bloc
+            for (std::size_t k = worker; k < count; k += workers)
+            {
+                std::size_t a = k * W;
+                std::size_t b = (k + 1 == count) ? top + 1 : (k + 1) * W;
+                left[k * H] = v[a];
+                for (std::size_t s = 1; s <= H; ++s)
+                {
+                    std::size_t n = top - s;
+                    std::size_t end = (k + 1 == count) ? n + 1 : b - s;
+                    induct_range(lattice, v, n, a, end);
+                    if (s < H)
+                        left[k * H + s] = v[a];
+                }
+            }
+            sync();
+
+            // Phase 2 : triangles [b - s, b) au raccord, avec les valeurs du
+            // nœud b sauvées par la tuile voisine. v[b] n'est lu ni écrit par
+            // aucune autre tuile pendant cette phase : on l'y substitue
+            for (std::size_t k = worker; k + 1 < count; k += workers)
+            {
+                std::size_t b = (k + 1) * W;
+                double saved = v[b];
+                for (std::size_t s = 1; s <= H; ++s)
+                {
+                    v[b] = left[(k + 1) * H + s - 1];
+                    induct_range(lattice, v, top - s, b - s, b);
+                }
+                v[b] = saved;
+            }
+            sync();
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (std::size_t w = 1; w < workers; ++w)
+        pool.emplace_back(work, w);
+    work(0);
+    for (auto& thread : pool)
+        thread.join();
+
+    std::size_t top = from;
+    while (tiled(top))
+        top -= H;
+    return top;
+}
+
+/* =========================================================
+   GREEKS PAR ARBRES BINOMIAUX (NŒUDS DE L'ARBRE DE PRIX)
+   ========================================================= */
+
+double BinomialTreePricer::delta(double spot) const
+{
+    // Delta sur les nœuds du pas 1 (ou du pas 2 de l'arbre étendu)
+    if (spot == S0_)
+        return price_and_greeks().delta;
+
+    BinomialTreePricer other(option_, spot, r_, b_, sigma_, N_, is_american_, type_, smoothing_);
+    other.extended_ = extended_;
+    other.threads_ = threads_;
+    other.truncation_ = truncation_;
+    other.set_dividends(dividends_);
+    return other.price_and_greeks().delta;
+}
+
+double BinomialTreePricer::gamma(double spot) const
+{
+    // Gamma sur les trois nœuds du pas 2 : aucun arbre supplémentaire
+    if (spot == S0_)
+        return price_and_greeks().gamma;
+
+    BinomialTreePricer other(option_, spot, r_, b_, sigma_, N_, is_american_, type_, smoothing_);
+    other.extended_ = extended_;
+    other.threads_ = threads_;
+    other.truncation_ = truncation_;
+    other.set_dividends(dividends_);
+    return other.price_and_greeks().gamma;
 }
 
 double BinomialTreePricer::theta() const
 {
-    // Theta : dérivée par rapport au temps
-    // On compare avec un arbre à N-2 pas (2Δt de différence)
-    
-    if (N_ < 3)
-        throw std::runtime_error("Not enough steps to compute theta");
-    
-    BinomialTreePricer shorter(option_, S0_, r_, b_, sigma_, N_-2, is_american_, type_);
-    
-    double dt_diff = 2.0 * dt_;
-    return (shorter.price() - price()) / dt_diff;
+    // Theta entre la racine et le nœud central du pas 2 (2Δt d'écart)
+    return price_and_greeks().theta;
 }
\ No newline at end of file
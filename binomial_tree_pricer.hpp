@@ -2,8 +2,21 @@
 
 #include "pricer.hpp"
 #include "option.hpp"
+#include "exercise_boundary.hpp"
+#include "dividend_schedule.hpp"
 #include <vector>
 
+/* =========================================================
+   PRIX ET GREEKS D'UN SEUL ARBRE
+   ========================================================= */
+struct TreeGreeks
+{
+    double price;
+    double delta;
+    double gamma;
+    double theta;
+};
+
 /* =========================================================
    ARBRES BINOMIAUX – OPTIONS AMÉRICAINES ET EUROPÉENNES
    ========================================================= */
@@ -14,7 +27,16 @@ public:
     enum class TreeType
     {
         CoxRossRubinstein,  // Arbre CRR standard
-        JarrowRudd        // Arbre JR (drift matching)
+        JarrowRudd,         // Arbre JR (drift matching)
+        LeisenReimer        // Arbre LR (inversion de Peizer-Pratt, N impair)
+    };
+
+    // Lissage du dernier pas de l'arbre
+    enum class Smoothing
+    {
+        None,
+        BlackScholes,           // BBS : valeurs Black-Scholes au dernier pas
+        BlackScholesRichardson  // BBSR : BBS + extrapolation de Richardson (N et N/2, N pair conseillé)
     };
 
     BinomialTreePricer(const Option& option,
@@ -24,19 +46,62 @@ public:
                        double volatility,
                        std::size_t steps, // std::size_t pour les tailles non négatives et tres grandes
                        bool is_american = false,
-                       TreeType type = TreeType::CoxRossRubinstein);
+                       TreeType type = TreeType::CoxRossRubinstein,
+                       Smoothing smoothing = Smoothing::None);
 
     double price() const override;
     double delta(double spot) const override;
     
-    // Greeks par arbres binomiaux
+    // Greeks par arbres binomiaux (lus sur les nœuds des pas 1 et 2)
     double gamma(double spot) const override;
     double theta() const override;
+
+    // Prix, delta, gamma et theta d'une seule induction rétrograde
+    TreeGreeks price_and_greeks() const;
+
+    // Chaîne d'options de même maturité (strikes, calls et puts) sur ce
+    // treillis : une seule remontée, valeurs entrelacées nœud × option.
+    // Pas pour Leisen-Reimer, dont le treillis dépend du strike
+    std::vector<TreeGreeks> price_chain(const std::vector<Option>& options) const;
+
+    // Frontière d'exercice S*(tau) relevée pendant la remontée (américain
+    // seulement) : hors de portée des nœuds, complétée par le voisin résolu
+    ExerciseBoundary exercise_boundary() const;
+
+    // Arbre démarré deux pas avant t = 0 : le spot est le nœud central du
+    // pas 2, delta et gamma sont centrés sur S0 à t = 0
+    void set_extended_tree(bool enabled);
+    bool extended_tree() const { return extended_; }
+
+    // Dividendes discrets (spot « escrowed ») : l'arbre recombinant porte
+    // S* = S - VA(dividendes restants), l'exercice se fait au spot réel
+    // S* + VA. Coût : un strike effectif par pas de temps. Modèle différent
+    // de FiniteDifferenceAmericanPricer::set_dividends (spot qui saute à la
+    // date ex) : sigma ne porte que sur S*, le spot réel est moins volatil
+    // et les prix diffèrent (put S = K = 100, deux dividendes de 2 : 7.456
+    // ici, 7.634 avec le saut)
+    void set_dividends(const DividendSchedule& dividends);
+    const DividendSchedule& dividends() const { return dividends_; }
+
+    // Troncature : seuls les nœuds de la bande fixe [min(S0, K), max(S0, K)]
+    // élargie de k sigma sqrt(T) en log sont remontés ; au-delà, valeur
+    // Black-Scholes (et exercice optimal si américaine). Écart à l'arbre
+    // complet ~1e-10 (k = 3, européen), ~1e-6 (américain avec dividendes),
+    // indépendant de N. Coût O(N^1.5) au lieu de O(N²) ; 0 désactive
+    // (défaut), sinon k >= 3. Un seul thread
+    void set_truncation(double width);
+    double truncation() const { return truncation_; }
+
+    // Threads de la remontée (0 : tous les cœurs). Seuls les grands arbres,
+    // découpés en tuiles, sont répartis ; le résultat ne dépend pas du nombre
+    void set_threads(std::size_t threads) { threads_ = threads; }
+    std::size_t threads() const { return threads_; }
     
     // Accès aux paramètres de l'arbre (utile pour debugging)
     double get_up_factor() const { return u_; }
     double get_down_factor() const { return d_; }
     double get_risk_neutral_prob() const { return p_; }
+    std::size_t get_steps() const { return N_; }
 
 private:
     // Calcul des paramètres de l'arbre selon le type
@@ -48,14 +113,77 @@ private:
     // JR : Jarrow-Rudd
     void compute_jr_parameters();
     
-    // Construction et évaluation de l'arbre
-    double evaluate_tree() const;
+    // LR : Leisen-Reimer
+    void compute_lr_parameters();
+    
+    // Inversion de Peizer-Pratt (méthode 2) pour n pas
+    static double peizer_pratt(double z, double n);
+    
+    // Prix Black-Scholes européen sur une durée tau (lissage BBS)
+    double black_scholes_value(const Payoff& payoff, double spot, double tau) const;
+    
+    // Construction et évaluation de l'arbre (Greeks sur les premiers pas)
+    TreeGreeks evaluate_tree() const;
+
+    // Géométrie d'une évaluation : S(i, n) = scale[n] * grid[i + offset - n / 2]
+    struct Lattice
+    {
+        std::size_t total;          // Nombre de pas
+        std::size_t offset;
+        double root;                // Spot à la racine
+        bool extended;              // Racine deux pas avant t = 0
+        std::vector<double> scale;  // Facteur par pas de temps
+        std::vector<double> grid;   // Puissances de u / d
+        double strike;
+        double phi;                 // +1 call, -1 put : exercice max(phi (S - K), 0)
+        double spot;                // Spot de l'arbre en t = 0 (S0 - dividendes)
+        std::vector<double> escrow; // Dividendes restants (valeur au pas n), nuls sans dividende
+    };
+
+    Lattice build_lattice() const;
+
+    // Condition terminale sur les nœuds du dernier pas
+    void terminal_values(const Lattice& lattice, std::vector<double>& values) const;
+
+    // Remontée commune d'une chaîne de payoffs
+    std::vector<TreeGreeks> evaluate_chain(const std::vector<const Payoff*>& payoffs) const;
+
+    // Greeks lus sur les nœuds des pas 1 et 2 et la racine
+    TreeGreeks read_greeks(const Lattice& lattice, const double* step2,
+                           const double* step1, double root_value) const;
+
+    // Remontée du pas n + 1 au pas n sur les nœuds [begin, end), en place
+    template <bool American>
+    void induct_range(const Lattice& lattice, double* values,
+                      std::size_t n, std::size_t begin, std::size_t end) const;
+    void induct_range(const Lattice& lattice, double* values,
+                      std::size_t n, std::size_t begin, std::size_t end) const;
+
+    // Remontée par tuiles (trapèzes puis triangles de raccord) du pas from
+    // vers le pas to au plus ; retourne le pas atteint
+    std::size_t induct_tiled(const Lattice& lattice, std::vector<double>& values,
+                             std::size_t from, std::size_t to) const;
+
+    // Remontée limitée à la bande de troncature du pas from vers le pas to
+    std::size_t induct_truncated(const Lattice& lattice, std::vector<double>& values,
+                                 std::size_t from, std::size_t to) const;
+
+    // Valeur au nœud (i, n) hors de la bande : Black-Scholes, exercice optimal si américaine
+    double edge_value(const Lattice& lattice, std::size_t n, std::size_t i) const;
+
+    // Largeur minimale de la bande de troncature (écarts-types)
+    static constexpr double kMinTruncation = 3.0;
+
+    // Découpage en tuiles : largeur (nœuds) et hauteur (pas) d'un bloc
+    static constexpr std::size_t kTileWidth = 4096;
+    static constexpr std::size_t kTileHeight = 256;
 
     const Option& option_;
     double S0_, r_, b_, sigma_;
     std::size_t N_;  // Nombre de pas
     bool is_american_;
     TreeType type_;
+    Smoothing smoothing_;
     
     // Paramètres de l'arbre
     double dt_;  // Pas de temps
@@ -63,5 +191,14 @@ private:
     double d_;   // Facteur de descente
     double p_;   // Probabilité risque-neutre
     double df_;  // Facteur d'actualisation
+
+    bool extended_ = false;
+    std::size_t threads_ = 1;
+    double truncation_ = 0.0;
+    DividendSchedule dividends_;
+
+    // Mise en cache : prix et Greeks viennent du même arbre
+    mutable TreeGreeks cached_greeks_;
+    mutable bool greeks_cached_ = false;
 };
 
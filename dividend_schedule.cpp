@@ -0,0 +1,33 @@
+#include "dividend_schedule.hpp"
+#include <cmath>
+#include <algorithm>
+#include <stdexcept>
+
+/* =========================================================
+   DIVIDENDES DISCRETS - IMPLÉMENTATION
+   ========================================================= */
+
+DividendSchedule::DividendSchedule(std::vector<CashDividend> dividends)
+    : dividends_(std::move(dividends))
+{
+    // Validation
+    for (const auto& dividend : dividends_)
+    {
+        if (!(dividend.time > 0.0))
+            throw std::invalid_argument("Dividend ex-date must be positive");
+        if (dividend.amount < 0.0)
+            throw std::invalid_argument("Dividend amount must be non-negative");
+    }
+
+    std::sort(dividends_.begin(), dividends_.end(),
+              [](const CashDividend& a, const CashDividend& b) { return a.time < b.time; });
+}
+
+double DividendSchedule::present_value(double t, double maturity, double rate) const
+{
+    double value = 0.0;
+    for (const auto& dividend : dividends_)
+        if (dividend.time >= t - 1e-12 && dividend.time < maturity)
+            value += dividend.amount * std::exp(-rate * (dividend.time - t));
+    return value;
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <vector>
+
+/* =========================================================
+   DIVIDENDES DISCRETS
+   ========================================================= */
+struct CashDividend
+{
+    double time;    // Date ex-dividende (années)
+    double amount;  // Montant en numéraire
+};
+
+// Échéancier de dividendes en numéraire, trié par date ex-dividende
+class DividendSchedule
+{
+public:
+    DividendSchedule() = default;
+    explicit DividendSchedule(std::vector<CashDividend> dividends);
+
+    bool empty() const { return dividends_.empty(); }
+    const std::vector<CashDividend>& dividends() const { return dividends_; }
+
+    // Valeur en t des dividendes de date ex dans [t, maturity), actualisés
+    // au taux rate (part « escrowed » du spot)
+    double present_value(double t, double maturity, double rate) const;
+
+private:
+    std::vector<CashDividend> dividends_;
+};
@@ -0,0 +1,101 @@
+#pragma once
+
+#include "option_type.hpp"
+#include <vector>
+
+/* =========================================================
+   VOLATILITÉ LOCALE SIGMA(K, T)
+   ========================================================= */
+
+// Surface tabulée sur une grille strikes x temps, interpolée linéairement
+// dans chaque direction et prolongée à plat au-delà des bords. Un seul
+// point : volatilité constante
+class LocalVolatilitySurface
+{
+public:
+    explicit LocalVolatilitySurface(double volatility);
+
+    // volatilities[j][i] : temps times[j], strike strikes[i] (croissants)
+    LocalVolatilitySurface(std::vector<double> strikes,
+                           std::vector<double> times,
+                           std::vector<std::vector<double>> volatilities);
+
+    double operator()(double strike, double time) const;
+
+    bool is_flat() const { return strikes_.size() == 1 && times_.size() == 1; }
+    double max_volatility() const;
+
+    const std::vector<double>& strikes() const { return strikes_; }
+    const std::vector<double>& times() const { return times_; }
+
+private:
+    // Intervalle [x_j, x_(j+1)] contenant x et poids de x_(j+1), bornés aux extrémités
+    static std::size_t locate(const std::vector<double>& nodes, double x, double& weight);
+
+    std::vector<double> strikes_, times_;
+    std::vector<double> volatilities_;  // Temps j, strike i : j * strikes + i
+};
+
+/* =========================================================
+   SURFACE DE PRIX STRIKE x MATURITÉ
+   ========================================================= */
+struct PriceSurface
+{
+    std::vector<double> strikes;
+    std::vector<double> maturities;
+    std::vector<std::vector<double>> prices;  // prices[j][i] : maturité j, strike i
+};
+
+/* =========================================================
+   ÉQUATION FORWARD DE DUPIRE
+   ========================================================= */
+
+// Prix des calls C(K, T) comme fonction du strike et de la maturité, S0 fixé :
+//   C_T = 0.5 sigma(K, T)² K² C_KK - b K C_K - (r - b) C,  C(K, 0) = (S0 - K)+
+// Une seule remontée en temps calendaire donne toutes les maturités, et
+// chaque tranche tous les strikes (au lieu d'une résolution rétrograde par
+// option). Grille en K sur [0, K_max], concentrée (sinh) sur S0, S0 sur un
+// nœud ; Crank-Nicolson avec démarrage de Rannacher (coude en K = S0).
+// Bords : C(0, T) = S0 exp((b - r) T), C(K_max, T) = 0. Puts par parité
+class DupirePricer
+{
+public:
+    DupirePricer(double spot,
+                 double rate,
+                 double carry,
+                 const LocalVolatilitySurface& volatility,
+                 std::size_t strike_points = 400,
+                 std::size_t steps = 200);  // Pas de temps jusqu'à la plus longue maturité
+
+    // Prix européens aux strikes x maturités (croissantes) demandés, lus sur
+    // chaque tranche (spline cubique en K)
+    PriceSurface price_surface(const std::vector<double>& strikes,
+                               const std::vector<double>& maturities,
+                               OptionType type = OptionType::Call) const;
+
+    const LocalVolatilitySurface& volatility() const { return volatility_; }
+
+private:
+    // Nœuds K_0 = 0 < ... < K_M, S0 exactement sur un nœud
+    void strike_grid(double max_strike, double horizon, std::vector<double>& nodes) const;
+
+    // Dérivées secondes de la spline cubique naturelle d'une tranche
+    static void fit_spline(const std::vector<double>& nodes, const std::vector<double>& values,
+                           std::vector<double>& curvature);
+    static double evaluate_spline(const std::vector<double>& nodes, const std::vector<double>& values,
+                                  const std::vector<double>& curvature, double strike);
+
+    // Borne haute en K : S0 exp(kDomainWidth sigma_max sqrt(T)), au moins
+    // kStrikeMargin fois le plus grand strike demandé
+    static constexpr double kDomainWidth = 6.0;
+    static constexpr double kStrikeMargin = 1.5;
+    static constexpr double kConcentration = 0.5;  // Zone dense en S0 sigma_max sqrt(T)
+    static constexpr std::size_t kRannacherSteps = 2;
+
+    // Poids w du terme quadratique de la grille en temps
+    static constexpr double kTimeGrading = 1.0;
+
+    double S0_, r_, b_;
+    LocalVolatilitySurface volatility_;
+    std::size_t M_, N_;
+};
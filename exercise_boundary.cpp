@@ -0,0 +1,278 @@
+#include "exercise_boundary.hpp"
+#include <cmath>
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+/* =========================================================
+   FRONTIÈRE D'EXERCICE - IMPLÉMENTATION
+   ========================================================= */
+
+namespace
+{
+    double normal_cdf(double x)
+    {
+        return 0.5 * std::erfc(-x / std::sqrt(2.0));
+    }
+
+    // Intégrale de f sur [0, tau] par Simpson en racine des deux côtés :
+    // s = sqrt(t) sur [0, tau / 2] absorbe le noyau en sqrt(t), w = sqrt(tau - t)
+    // sur [tau / 2, tau] la frontière en sqrt(tau') près de la maturité
+    template <typename F>
+    double sqrt_simpson(F&& f, double tau, std::size_t panels)
+    {
+        double h = std::sqrt(0.5 * tau) / static_cast<double>(panels);
+        double sum = 0.0;
+        for (std::size_t k = 1; k <= panels; ++k)
+        {
+            double x = static_cast<double>(k) * h;
+            double weight = (k == panels) ? 1.0 : ((k % 2) ? 4.0 : 2.0);
+            sum += weight * 2.0 * x * (f(x * x) + f(tau - x * x));
+        }
+        return sum * h / 3.0;
+    }
+}
+
+ExerciseBoundary::ExerciseBoundary(OptionType type,
+                                   double strike,
+                                   double rate,
+                                   double carry,
+                                   double volatility,
+                                   std::vector<double> tau,
+                                   std::vector<double> spots)
+    : type_(type),
+      K_(strike),
+      r_(rate),
+      b_(carry),
+      sigma_(volatility),
+      tau_(std::move(tau)),
+      spots_(std::move(spots))
+{
+    // Validation
+    if (volatility <= 0.0)
+        throw std::invalid_argument("Volatility must be positive");
+    if (tau_.size() != spots_.size() || tau_.size() < 2)
+        throw std::invalid_argument("Boundary needs at least two (tau, spot) points");
+    for (std::size_t n = 1; n < tau_.size(); ++n)
+        if (tau_[n] <= tau_[n - 1])
+            throw std::invalid_argument("Boundary times must be increasing");
+
+    // Points non résolus (frontière hors du treillis) : voisin résolu le plus proche
+    std::size_t count = spots_.size();
+    std::size_t first = 0;
+    while (first < count && std::isnan(spots_[first]))
+        ++first;
+
+    if (first == count)
+    {
+        // Jamais d'exercice observé
+        double never = (type_ == OptionType::Put) ? 0.0 : std::numeric_limits<double>::infinity();
+        std::fill(spots_.begin(), spots_.end(), never);
+        return;
+    }
+
+    for (std::size_t n = 0; n < first; ++n)
+        spots_[n] = spots_[first];
+    for (std::size_t n = first + 1; n < count; ++n)
+        if (std::isnan(spots_[n]))
+            spots_[n] = spots_[n - 1];
+}
+
+void ExerciseBoundary::refine(std::size_t iterations)
+{
+    // Frontière relevée depuis la maturité, exercice observé
+    double limit = expiry_limit(type_, K_, r_, b_);
+    double last = spots_.back();
+    if (tau_.front() != 0.0 || std::isinf(limit) || std::isinf(last) || !(last > 0.0))
+        return;
+
+    // Grille en sqrt(tau) sur [0, T], initialisée par les points relevés
+    double T = maturity();
+    std::vector<double> tau(1, 0.0), spots(1, limit);
+    for (std::size_t j = 1; j <= kBoundaryNodes; ++j)
+    {
+        double u = static_cast<double>(j) / static_cast<double>(kBoundaryNodes);
+        tau.push_back((j == kBoundaryNodes) ? T : T * u * u);
+        spots.push_back(critical_spot(tau.back()));
+    }
+    tau_ = std::move(tau);
+    spots_ = std::move(spots);
+
+    // Appariement de valeur en B (intrinsèque = européen + prime) réécrit en
+    // point fixe (Andersen-Lake-Offengelden, FP-A), phi = 1 call, -1 put :
+    //   B = K [e^{-r tau} N(-phi d2) + r ∫ e^{-rt} N(-phi d2(t)) dt]
+    //       / [e^{-q tau} N(-phi d1) + q ∫ e^{-qt} N(-phi d1(t)) dt]
+    // avec d1(t), d2(t) en B(tau) / B(tau - t). Gauss-Seidel, tau croissant
+    double q = r_ - b_;
+    double phi = (type_ == OptionType::Call) ? 1.0 : -1.0;
+    auto d1 = [&](double t, double ratio)
+    {
+        return (std::log(ratio) + (b_ + 0.5 * sigma_ * sigma_) * t) / (sigma_ * std::sqrt(t));
+    };
+
+    for (std::size_t iteration = 0; iteration < iterations; ++iteration)
+    {
+        double change = 0.0;
+        for (std::size_t j = 1; j <= kBoundaryNodes; ++j)
+        {
+            double t_j = tau_[j];
+            double B = spots_[j];
+
+            double numerator = std::exp(-r_ * t_j) * normal_cdf(-phi * (d1(t_j, B / K_) - sigma_ * std::sqrt(t_j)))
+                + r_ * sqrt_simpson([&](double t)
+                  {
+                      double d2 = d1(t, B / critical_spot(t_j - t)) - sigma_ * std::sqrt(t);
+                      return std::exp(-r_ * t) * normal_cdf(-phi * d2);
+                  }, t_j, kPremiumPanels);
+            double denominator = std::exp(-q * t_j) * normal_cdf(-phi * d1(t_j, B / K_))
+                + q * sqrt_simpson([&](double t)
+                  {
+                      return std::exp(-q * t) * normal_cdf(-phi * d1(t, B / critical_spot(t_j - t)));
+                  }, t_j, kPremiumPanels);
+
+            double updated = K_ * numerator / denominator;
+            change = std::max(change, std::abs(updated - B) / B);
+            spots_[j] = updated;
+        }
+        if (change < 1e-8)
+            break;
+    }
+}
+
+double ExerciseBoundary::expiry_limit(OptionType type, double strike, double rate, double carry)
+{
+    double q = rate - carry;
+
+    if (type == OptionType::Put)
+        return (q > 0.0) ? strike * std::min(1.0, rate / q) : strike;
+
+    // Call : jamais exercé sans dividende (q <= 0)
+    if (q <= 0.0)
+        return std::numeric_limits<double>::infinity();
+    return strike * std::max(1.0, rate / q);
+}
+
+double ExerciseBoundary::locate(double S_ex, double S1, double g1, double S2, double g2)
+{
+    // sqrt(V - payoff) est linéaire en S près de la frontière
+    double r1 = std::sqrt(std::max(g1, 0.0));
+    double r2 = std::sqrt(std::max(g2, 0.0));
+    if (r2 <= r1)
+        return 0.5 * (S_ex + S1);
+
+    double critical = S1 - r1 * (S2 - S1) / (r2 - r1);
+    return std::clamp(critical, std::min(S_ex, S1), std::max(S_ex, S1));
+}
+
+double ExerciseBoundary::critical_from_slice(OptionType type, double strike,
+                                             const double* spots, const double* values,
+                                             std::size_t count)
+{
+    double nan = std::numeric_limits<double>::quiet_NaN();
+    double phi = (type == OptionType::Call) ? 1.0 : -1.0;
+
+    // Écart à l'exercice : nul exactement sur les nœuds exercés (max)
+    auto gap = [&](std::size_t i) { return values[i] - std::max(phi * (spots[i] - strike), 0.0); };
+    auto exercised = [&](std::size_t i) { return phi * (spots[i] - strike) > 0.0 && gap(i) <= 0.0; };
+
+    if (type == OptionType::Put)
+    {
+        // Zone d'exercice en bas de la tranche
+        if (count == 0 || !exercised(0))
+            return nan;
+        std::size_t j = 0;
+        while (j + 1 < count && exercised(j + 1))
+            ++j;
+        if (j + 1 == count)
+            return nan;
+        if (j + 2 == count)
+            return spots[j];
+        return locate(spots[j], spots[j + 1], gap(j + 1), spots[j + 2], gap(j + 2));
+    }
+
+    // Call : zone d'exercice en haut de la tranche
+    if (count == 0 || !exercised(count - 1))
+        return nan;
+    std::size_t j = count - 1;
+    while (j > 0 && exercised(j - 1))
+        --j;
+    if (j == 0)
+        return nan;
+    if (j == 1)
+        return spots[j];
+    return locate(spots[j], spots[j - 1], gap(j - 1), spots[j - 2], gap(j - 2));
+}
+
+double ExerciseBoundary::critical_spot(double tau) const
+{
+    if (tau <= tau_.front())
+        return spots_.front();
+    if (tau >= tau_.back())
+        return spots_.back();
+
+    std::size_t n = static_cast<std::size_t>(std::upper_bound(tau_.begin(), tau_.end(), tau) - tau_.begin());
+    double w = (tau - tau_[n - 1]) / (tau_[n] - tau_[n - 1]);
+
+    // Frontière infinie (call sans dividende) : pas d'interpolation
+    if (std::isinf(spots_[n - 1]) || std::isinf(spots_[n]))
+        return (w < 0.5) ? spots_[n - 1] : spots_[n];
+    return (1.0 - w) * spots_[n - 1] + w * spots_[n];
+}
+
+bool ExerciseBoundary::is_exercise(double spot, double tau) const
+{
+    double critical = critical_spot(tau);
+    return (type_ == OptionType::Put) ? spot <= critical : spot >= critical;
+}
+
+/* =========================================================
+   PRIX PAR L'INTÉGRALE DE PRIME D'EXERCICE ANTICIPÉ
+   ========================================================= */
+
+double ExerciseBoundary::european_price(double spot, double tau) const
+{
+    double vol = sigma_ * std::sqrt(tau);
+    double df = std::exp(-r_ * tau);
+    double ff = std::exp((b_ - r_) * tau);
+    double d1 = (std::log(spot / K_) + (b_ + 0.5 * sigma_ * sigma_) * tau) / vol;
+    double d2 = d1 - vol;
+
+    if (type_ == OptionType::Call)
+        return spot * ff * normal_cdf(d1) - K_ * df * normal_cdf(d2);
+    else
+        return K_ * df * normal_cdf(-d2) - spot * ff * normal_cdf(-d1);
+}
+
+double ExerciseBoundary::price(double spot) const
+{
+    return price(spot, maturity());
+}
+
+double ExerciseBoundary::price(double spot, double tau) const
+{
+    if (spot <= 0.0)
+        throw std::invalid_argument("Spot must be positive");
+    if (tau > maturity() + 1e-12)
+        throw std::invalid_argument("Time to maturity beyond the stored boundary");
+
+    double intrinsic = (type_ == OptionType::Call) ? std::max(spot - K_, 0.0) : std::max(K_ - spot, 0.0);
+    if (tau <= 0.0 || is_exercise(spot, tau))
+        return intrinsic;
+
+    double q = r_ - b_;
+    double phi = (type_ == OptionType::Call) ? 1.0 : -1.0;
+
+    // Intégrande de la prime à t (temps écoulé), frontière en tau - t
+    auto integrand = [&](double t)
+    {
+        double critical = critical_spot(tau - t);
+        double vol = sigma_ * std::sqrt(t);
+        double d1 = (std::log(spot / critical) + (b_ + 0.5 * sigma_ * sigma_) * t) / vol;
+        double d2 = d1 - vol;
+        return phi * (q * spot * std::exp(-q * t) * normal_cdf(phi * d1)
+                      - r_ * K_ * std::exp(-r_ * t) * normal_cdf(phi * d2));
+    };
+
+    double premium = sqrt_simpson(integrand, tau, kPremiumPanels);
+    return std::max(european_price(spot, tau) + premium, intrinsic);
+}
@@ -35,196 +35,1380 @@ FiniteDifferenceAmericanPricer::FiniteDifferenceAmericanPricer(
         throw std::invalid_argument("M too small (need at least 10 space points)");
     if (N < 10)
         throw std::invalid_argument("N too small (need at least 10 time points)");
+
+    barrier_ = dynamic_cast<const BarrierPayoff*>(&option.payoff());
 }
 
 double FiniteDifferenceAmericanPricer::price() const
 {
+    return price_and_greeks().price;
+}
+
+double FiniteDifferenceAmericanPricer::implicit_weight() const
+{
+    // Poids de la partie implicite : V_n - theta dt L V_n = V_(n+1) + (1 - theta) dt L V_(n+1)
     switch (scheme_)
     {
     case Scheme::Explicit:
-        return price_explicit();
+        return 0.0;
     case Scheme::Implicit:
-        return price_implicit();
+        return 1.0;
     case Scheme::CrankNicolson:
-        return price_crank_nicolson();
+        return 0.5;
     default:
         throw std::runtime_error("Unknown scheme");
     }
 }
 
-double FiniteDifferenceAmericanPricer::price_explicit() const
+FiniteDifferenceAmericanPricer::Workspace& FiniteDifferenceAmericanPricer::workspace()
+{
+    // Une arène par thread : les vecteurs gardent leur capacité d'un prix à l'autre
+    thread_local Workspace arena;
+    return arena;
+}
+
+void FiniteDifferenceAmericanPricer::solve(Solution& solution, bool knock_out,
+                                           std::vector<double>* boundary) const
 {
-    // Schéma explicite 
+    double scheme_theta = implicit_weight();
     double T = option_.maturity();
-    double dS = Smax_ / static_cast<double>(M_);
-    double dt = T / static_cast<double>(N_);
+    std::size_t size = M_ + 1;
+    bool american = (exercise_ == Exercise::American);
 
-    std::vector<double> grid(M_ + 1), newGrid(M_ + 1);
+    Workspace& w = workspace();
+    spot_grid(w.nodes, knock_out);
+    time_grid(w.times);
 
-    // Condition terminale
-    for (std::size_t i = 0; i <= M_; ++i)
-        grid[i] = option_.payoff().payoff_spot(static_cast<double>(i) * dS);
+    // Pas n -> n + 1 : constant sur la grille uniforme sans date insérée
+    // (une seule factorisation)
+    std::size_t steps = w.times.size() - 1;
+    bool uniform = !graded_ && steps == N_;
+    auto step_size = [&](std::size_t n)
+    {
+        return uniform ? T / static_cast<double>(N_) : w.times[n + 1] - w.times[n];
+    };
 
-    // Remonter dans le temps
-    for (std::size_t n = N_; n-- > 0;)
+    // Obstacle (valeur d'exercice) aux nœuds, calculé une fois ; condition terminale
+    w.obstacle.resize(size);
+    for (std::size_t i = 0; i < size; ++i)
+        w.obstacle[i] = option_.payoff().payoff_spot(w.nodes[i]);
+    w.grid = w.obstacle;
+    w.next.resize(size);
+
+    // Barrière : nœud de bord du domaine tronqué (continue) ou dates de surveillance
+    bool continuous = knock_out && monitoring_dates_.empty();
+    bool lower_barrier = continuous && barrier_->direction() == BarrierPayoff::Direction::Down;
+    bool upper_barrier = continuous && barrier_->direction() == BarrierPayoff::Direction::Up;
+    w.monitored.assign(steps + 1, 0);
+    if (knock_out && !continuous)
+        monitoring_steps(w.times, w.monitored);
+
+    if (lower_barrier)
+        w.grid[0] = rebate_;
+    if (upper_barrier)
+        w.grid[M_] = rebate_;
+    if (w.monitored[steps])
+        apply_knock_out(w.grid, w.nodes);
+
+    // Dividendes par pas (date ex à maturité près : dernier pas)
+    dividend_steps(w.times, w.dividend);
+    if (w.dividend[steps] > 0.0)
+        apply_dividend(w.grid, w.nodes, w.obstacle, w.dividend[steps]);
+
+    // Opérateur constant en temps ; le pas explicite est stable (coefficients
+    // positifs) tant que 1 + dt diag_i >= 0, soit dt <= 1 / max(-diag_i)
+    build_operator(w.nodes, w.lower, w.diag, w.upper);
+    double stiffness = 0.0;
+    for (std::size_t i = 1; i < M_; ++i)
+        stiffness = std::max(stiffness, -w.diag[i]);
+
+    w.a.assign(size, 0.0);
+    w.b.assign(size, 1.0);
+    w.c.assign(size, 0.0);
+    w.d.resize(size);
+    w.explicit_lower.assign(size, 0.0);
+    w.explicit_diag.assign(size, 0.0);
+    w.explicit_upper.assign(size, 0.0);
+
+    // Systèmes (I - theta dt L), factorisés quand dt ou theta change (une
+    // fois sur la grille uniforme), second membre (I + (1 - theta) dt L) V.
+    // Lignes 0 et M : V = obstacle
+    double theta = scheme_theta, factored_step = 0.0, factored_theta = -1.0;
+    auto prepare = [&](double dt)
     {
+        // Explicite au-delà de la limite de stabilité : pas implicite
+        theta = (scheme_theta == 0.0 && dt * stiffness > 1.0) ? 1.0 : scheme_theta;
+        if (dt == factored_step && theta == factored_theta)
+            return;
+
         for (std::size_t i = 1; i < M_; ++i)
         {
-            double S = static_cast<double>(i) * dS;
+            w.a[i] = -theta * dt * w.lower[i];
+            w.b[i] = 1.0 - theta * dt * w.diag[i];
+            w.c[i] = -theta * dt * w.upper[i];
+            w.explicit_lower[i] = (1.0 - theta) * dt * w.lower[i];
+            w.explicit_diag[i] = 1.0 + (1.0 - theta) * dt * w.diag[i];
+            w.explicit_upper[i] = (1.0 - theta) * dt * w.upper[i];
+        }
+        factorize(w);
+        factored_step = dt;
+        factored_theta = theta;
+    };
+
+    // Démarrage de Rannacher : deux demi-pas implicites, de matrice
+    // I - dt / 2 L, celle de Crank-Nicolson (même factorisation)
+    bool rannacher = (scheme_theta == 0.5 && rannacher_steps_ > 0);
+    std::size_t smoothing = rannacher ? rannacher_steps_ : 0;
+
+    // Problème de complémentarité : système tridiagonal sous l'obstacle
+    // (explicite : système identité, la projection est exacte). Lignes 0 et
+    // M : conditions de Dirichlet au temps restant tau
+    double tau = 0.0;
+    auto step = [&]()
+    {
+        double* d = w.d.data();
+        d[0] = edge_value(w.nodes[0], tau, lower_barrier);
+        d[M_] = edge_value(w.nodes[M_], tau, upper_barrier);
+
+        if (theta == 0.0)
+        {
+            for (std::size_t i = 0; i < size; ++i)
+                w.next[i] = american ? std::max(d[i], w.obstacle[i]) : d[i];
+        }
+        else if (!american)
+        {
+            substitute(w, nullptr, w.next.data());
+        }
+        else
+        {
+            solve_constrained(w);
+        }
+    };
+
+    // Remonter dans le temps
+    for (std::size_t n = steps; n-- > 0;)
+    {
+        double dt = step_size(n);
+        tau = T - w.times[n];
+        prepare(dt);
+
+        if (smoothing > 0)
+        {
+            // Deux demi-pas implicites : second membre V, sans partie
+            // explicite ; bords au temps restant de chaque demi-pas
+            std::copy(w.grid.begin() + 1, w.grid.end() - 1, w.d.begin() + 1);
+            tau -= 0.5 * dt;
+            step();
+            w.grid.swap(w.next);
+            std::copy(w.grid.begin() + 1, w.grid.end() - 1, w.d.begin() + 1);
+            tau += 0.5 * dt;
+            step();
+            --smoothing;
+        }
+        else
+        {
+            // Partie explicite : stencil à trois points sur tableaux contigus (vectorisé)
+            const double* g = w.grid.data();
+            const double* el = w.explicit_lower.data();
+            const double* ed = w.explicit_diag.data();
+            const double* eu = w.explicit_upper.data();
+            double* d = w.d.data();
+            for (std::size_t i = 1; i < M_; ++i)
+                d[i] = el[i] * g[i - 1] + ed[i] * g[i] + eu[i] * g[i + 1];
+
+            step();
+        }
+
+        // Frontière d'exercice sur les nœuds intérieurs
+        if (boundary)
+            record_boundary(w.next, w.nodes, *boundary);
+
+        // Date ex au pas n : valeur juste avant le détachement, nouveau coude
+        if (w.dividend[n] > 0.0)
+        {
+            apply_dividend(w.next, w.nodes, w.obstacle, w.dividend[n]);
+            if (rannacher)
+                smoothing = rannacher_steps_;
+        }
+
+        // Date de surveillance : knock-out au-delà de la barrière, discontinuité
+        if (w.monitored[n])
+        {
+            apply_knock_out(w.next, w.nodes);
+            if (rannacher)
+                smoothing = rannacher_steps_;
+        }
 
-            double delta = (grid[i + 1] - grid[i - 1]) / (2.0 * dS);
-            double gamma = (grid[i + 1] - 2.0 * grid[i] + grid[i - 1]) / (dS * dS);
+        // Tranche t = dt pour theta
+        if (n == 1)
+            w.later = w.next;
 
-            double cont = grid[i] + dt * (
-                0.5 * sigma_ * sigma_ * S * S * gamma
-                + b_ * S * delta
-                - r_ * grid[i]);
+        w.grid.swap(w.next);
+    }
+
+    // Cache : tranche t = 0 et sa spline, valeur en S0 à t = dt (rebate si
+    // S0 est au-delà de la barrière du domaine tronqué)
+    solution.nodes = w.nodes;
+    solution.values = w.grid;
+    fit_spline(solution.nodes, solution.values, solution.curvature);
+
+    solution.later_time = step_size(0);
+    solution.later_value = rebate_;
+    if (S0_ >= w.nodes.front() && S0_ <= w.nodes.back())
+    {
+        double unused_delta, unused_gamma;
+        std::vector<double>& later_curvature = w.spline[5];
+        fit_spline(w.nodes, w.later, later_curvature);
+        evaluate_spline(w.nodes, w.later, later_curvature, S0_, solution.later_value, unused_delta, unused_gamma);
+    }
+}
+
+bool FiniteDifferenceAmericanPricer::knock_in() const
+{
+    return barrier_ && barrier_->knock() == BarrierPayoff::Knock::In;
+}
+
+void FiniteDifferenceAmericanPricer::ensure_solved() const
+{
+    if (solved_)
+        return;
+
+    if (tolerance_ > 0.0)
+    {
+        refine();
+        solved_ = true;
+        return;
+    }
+
+    // Knock-in = vanille - knock-out de même barrière, valable en européen seulement
+    if (knock_in())
+    {
+        if (exercise_ == Exercise::American)
+            throw std::invalid_argument("American knock-in has no in/out parity (use TrinomialBarrierPricer)");
+        if (rebate_ != 0.0)
+            throw std::invalid_argument("Rebate only applies to knock-out barriers");
+        solve(vanilla_, false);
+    }
+
+    solve(solution_, barrier_ != nullptr);
+    solved_ = true;
+}
+
+void FiniteDifferenceAmericanPricer::read(double spot, double& value, double& delta, double& gamma) const
+{
+    ensure_solved();
+
+    // Erreur contrôlée : extrapolation de Richardson des deux dernières grilles
+    if (tolerance_ > 0.0)
+    {
+        double coarse_value, coarse_delta, coarse_gamma;
+        fine_level_->read(spot, value, delta, gamma);
+        coarse_level_->read(spot, coarse_value, coarse_delta, coarse_gamma);
+        value = extrapolate(value, coarse_value);
+        delta = extrapolate(delta, coarse_delta);
+        gamma = extrapolate(gamma, coarse_gamma);
+        return;
+    }
 
-            newGrid[i] = std::max(cont, option_.payoff().payoff_spot(S));
+    // Surveillance continue, barrière déjà franchie : éteint ou vanille
+    if (barrier_ && monitoring_dates_.empty() && barrier_->is_breached(spot))
+    {
+        if (knock_in())
+        {
+            evaluate_spline(vanilla_.nodes, vanilla_.values, vanilla_.curvature, spot, value, delta, gamma);
         }
+        else
+        {
+            value = rebate_;
+            delta = gamma = 0.0;
+        }
+        return;
+    }
+
+    evaluate_spline(solution_.nodes, solution_.values, solution_.curvature, spot, value, delta, gamma);
+    if (knock_in())
+    {
+        double vanilla_value, vanilla_delta, vanilla_gamma;
+        evaluate_spline(vanilla_.nodes, vanilla_.values, vanilla_.curvature, spot,
+                        vanilla_value, vanilla_delta, vanilla_gamma);
+        value = vanilla_value - value;
+        delta = vanilla_delta - delta;
+        gamma = vanilla_gamma - gamma;
+    }
+}
+
+/* =========================================================
+   GREEKS ET PROFIL SUR LA GRILLE
+   ========================================================= */
+
+GridGreeks FiniteDifferenceAmericanPricer::price_and_greeks() const
+{
+    GridGreeks greeks;
+    read(S0_, greeks.price, greeks.delta, greeks.gamma);
+
+    if (tolerance_ > 0.0)
+    {
+        greeks.theta = extrapolate(fine_level_->theta(), coarse_level_->theta());
+        return greeks;
+    }
+
+    // Theta entre t = 0 et t = dt au même spot
+    double later = knock_in() ? vanilla_.later_value - solution_.later_value : solution_.later_value;
+    greeks.theta = (later - greeks.price) / solution_.later_time;
+    return greeks;
+}
+
+PriceProfile FiniteDifferenceAmericanPricer::price_profile(const std::vector<double>& spots) const
+{
+    PriceProfile profile;
+    profile.spots = spots;
+    profile.prices.resize(spots.size());
+    profile.deltas.resize(spots.size());
+    profile.gammas.resize(spots.size());
+
+    for (std::size_t k = 0; k < spots.size(); ++k)
+        read(spots[k], profile.prices[k], profile.deltas[k], profile.gammas[k]);
+    return profile;
+}
+
+double FiniteDifferenceAmericanPricer::delta(double spot) const
+{
+    return price_profile({spot}).deltas[0];
+}
+
+double FiniteDifferenceAmericanPricer::gamma(double spot) const
+{
+    return price_profile({spot}).gammas[0];
+}
+
+double FiniteDifferenceAmericanPricer::theta() const
+{
+    return price_and_greeks().theta;
+}
+
+/* =========================================================
+   ERREUR CONTRÔLÉE (RICHARDSON)
+   ========================================================= */
+
+void FiniteDifferenceAmericanPricer::set_tolerance(double tolerance)
+{
+    if (tolerance < 0.0)
+        throw std::invalid_argument("Tolerance must be non-negative");
+
+    tolerance_ = tolerance;
+    solved_ = false;
+}
+
+double FiniteDifferenceAmericanPricer::error_estimate() const
+{
+    if (tolerance_ <= 0.0)
+        throw std::invalid_argument("Error estimate needs a tolerance (set_tolerance)");
+    ensure_solved();
+    return error_estimate_;
+}
+
+std::size_t FiniteDifferenceAmericanPricer::space_points() const
+{
+    if (tolerance_ <= 0.0)
+        return M_;
+    ensure_solved();
+    return fine_level_->M_;
+}
+
+std::size_t FiniteDifferenceAmericanPricer::time_steps() const
+{
+    if (tolerance_ <= 0.0)
+        return N_;
+    ensure_solved();
+    return fine_level_->N_;
+}
+
+double FiniteDifferenceAmericanPricer::extrapolate(double fine, double coarse) const
+{
+    return fine + (fine - coarse) / (std::exp2(order_) - 1.0);
+}
+
+void FiniteDifferenceAmericanPricer::refine() const
+{
+    // Niveau k : grille de départ (M, N) raffinée 2^k fois en espace et en
+    // temps, pas de temps croissants depuis la maturité
+    auto level = [&](std::size_t k)
+    {
+        auto pricer = std::make_shared<FiniteDifferenceAmericanPricer>(*this);
+        pricer->tolerance_ = 0.0;
+        pricer->graded_ = true;
+        pricer->M_ = M_ << k;
+        pricer->N_ = N_ << k;
+        pricer->fine_level_.reset();
+        pricer->coarse_level_.reset();
+        pricer->solved_ = false;
+        return pricer;
+    };
+
+    // Ordre de convergence observé sur trois grilles (borné à [1, 2]) ; sur
+    // deux seulement, ordre nominal du schéma. Erreur estimée : celle du prix
+    // de la grille fine, |V_h - V_2h| / (2^p - 1), borne prudente pour le
+    // prix extrapolé (un écart entre extrapolations successives peut
+    // s'annuler par hasard)
+    std::vector<double> prices;
+    std::shared_ptr<const FiniteDifferenceAmericanPricer> coarse = level(0);
+    prices.push_back(coarse->price());
+    for (std::size_t k = 1; k <= kMaxRefinements; ++k)
+    {
+        std::shared_ptr<const FiniteDifferenceAmericanPricer> fine = level(k);
+        prices.push_back(fine->price());
+
+        double change = std::fabs(prices[k] - prices[k - 1]);
+        order_ = (scheme_ == Scheme::CrankNicolson) ? 2.0 : 1.0;
+        if (k >= 2 && change > 0.0)
+            order_ = std::clamp(std::log2(std::fabs(prices[k - 1] - prices[k - 2]) / change), 1.0, 2.0);
+
+        error_estimate_ = change / (std::exp2(order_) - 1.0);
+        fine_level_ = fine;
+        coarse_level_ = coarse;
+        if (error_estimate_ <= tolerance_)
+            break;
+        coarse = fine;
+    }
+}
+
+void FiniteDifferenceAmericanPricer::set_rannacher_steps(std::size_t steps)
+{
+    rannacher_steps_ = steps;
+    solved_ = false;
+}
+
+void FiniteDifferenceAmericanPricer::set_exercise(Exercise exercise)
+{
+    exercise_ = exercise;
+    solved_ = false;
+}
+
+void FiniteDifferenceAmericanPricer::set_dividends(const DividendSchedule& dividends)
+{
+    dividends_ = dividends;
+    solved_ = false;
+}
+
+/* =========================================================
+   CHAÎNE D'OPTIONS – BLOCS ENTRELACÉS
+   ========================================================= */
+
+std::vector<GridGreeks> FiniteDifferenceAmericanPricer::price_chain(const std::vector<Option>& options,
+                                                                    const std::vector<double>& volatilities) const
+{
+    if (options.empty())
+        throw std::invalid_argument("Chain must contain at least one option");
+    if (!volatilities.empty() && volatilities.size() != options.size())
+        throw std::invalid_argument("Chain needs one volatility per option (or none)");
+    if (grid_ != Grid::Uniform)
+        throw std::invalid_argument("Chain pricing needs the uniform grid shared by all options");
+    if (!dividends_.empty())
+        throw std::invalid_argument("Chain pricing does not support discrete dividends");
+    if (tolerance_ > 0.0)
+        throw std::invalid_argument("Chain pricing uses the fixed (M, N) grid: no tolerance");
+    if (exercise_ == Exercise::American && scheme_ != Scheme::Explicit && constraint_ != Constraint::Projection)
+        throw std::invalid_argument("Chain pricing applies the American constraint by projection");
 
-        newGrid[0] = option_.payoff().payoff_spot(0.0);
-        newGrid[M_] = option_.payoff().payoff_spot(Smax_);
+    std::vector<const Payoff*> payoffs;
+    std::vector<double> sigmas;
+    for (std::size_t k = 0; k < options.size(); ++k)
+    {
+        const Option& opt = options[k];
+        if (std::abs(opt.maturity() - option_.maturity()) > 1e-12)
+            throw std::invalid_argument("All options must share the pricer maturity");
+        if (dynamic_cast<const BarrierPayoff*>(&opt.payoff()))
+            throw std::invalid_argument("Barrier options cannot be priced in a chain");
 
-        grid.swap(newGrid);
+        double sigma = volatilities.empty() ? sigma_ : volatilities[k];
+        if (sigma <= 0.0)
+            throw std::invalid_argument("Volatility must be positive");
+        payoffs.push_back(&opt.payoff());
+        sigmas.push_back(sigma);
     }
 
-    // Interpolation linéaire
-    std::size_t i = static_cast<std::size_t>(S0_ / dS);
-    double w = (S0_ - static_cast<double>(i) * dS) / dS;
-    return (1.0 - w) * grid[i] + w * grid[i + 1];
+    std::vector<GridGreeks> result(options.size());
+    for (std::size_t first = 0; first < options.size(); first += kChainLanes)
+        solve_chain(payoffs, sigmas, first, result.data() + first);
+    return result;
 }
 
-// Schéma implicite
-double FiniteDifferenceAmericanPricer::price_implicit() const
+void FiniteDifferenceAmericanPricer::solve_chain(const std::vector<const Payoff*>& payoffs,
+                                                 const std::vector<double>& volatilities,
+                                                 std::size_t first, GridGreeks* greeks) const
 {
+    // Valeur de l'option k au nœud i : V[i * L + k]. Toutes les boucles
+    // internes portent sur k, de longueur fixe L, que le compilateur peut
+    // vectoriser pour le stencil, l'élimination et la projection
+    constexpr std::size_t L = kChainLanes;
+    double theta = implicit_weight();
     double T = option_.maturity();
-    double dS = Smax_ / static_cast<double>(M_);
     double dt = T / static_cast<double>(N_);
+    std::size_t size = M_ + 1;
+    bool american = (exercise_ == Exercise::American);
 
-    std::vector<double> grid(M_ + 1), newGrid(M_ + 1);
+    std::size_t used = std::min(L, payoffs.size() - first);
+    const Payoff* payoff[L];
+    double sigma[L];
+    for (std::size_t k = 0; k < L; ++k)
+    {
+        payoff[k] = payoffs[first + std::min(k, used - 1)];
+        sigma[k] = volatilities[first + std::min(k, used - 1)];
+    }
 
-    // Condition terminale
-    for (std::size_t i = 0; i <= M_; ++i)
-        grid[i] = option_.payoff().payoff_spot(static_cast<double>(i) * dS);
+    // Grille uniforme de la résolution scalaire ; tampons du thread, entrelacés
+    Workspace& w = workspace();
+    w.nodes.resize(size);
+    for (std::size_t i = 0; i < size; ++i)
+        w.nodes[i] = static_cast<double>(i) * Smax_ / static_cast<double>(M_);
+    const double* nodes = w.nodes.data();
 
-    // Coefficients pour système tridiagonal
-    std::vector<double> a(M_ + 1), b(M_ + 1), c(M_ + 1), d(M_ + 1);
+    w.obstacle.resize(size * L);
+    for (std::size_t i = 0; i < size; ++i)
+        for (std::size_t k = 0; k < L; ++k)
+            w.obstacle[i * L + k] = payoff[k]->payoff_spot(nodes[i]);
+    w.grid = w.obstacle;
+    w.next.resize(size * L);
+    w.d.resize(size * L);
+
+    // Opérateur de chaque option (même stencil que build_operator), rangé
+    // dans les tableaux explicites
+    w.explicit_lower.assign(size * L, 0.0);
+    w.explicit_diag.assign(size * L, 0.0);
+    w.explicit_upper.assign(size * L, 0.0);
+    double stiffness = 0.0;
+    for (std::size_t i = 1; i < M_; ++i)
+    {
+        double S = nodes[i];
+        double hm = S - nodes[i - 1], hp = nodes[i + 1] - S;
+        double d1_down = -hp / (hm * (hm + hp)), d1_mid = (hp - hm) / (hm * hp), d1_up = hm / (hp * (hm + hp));
+        double d2_down = 2.0 / (hm * (hm + hp)), d2_mid = -2.0 / (hm * hp), d2_up = 2.0 / (hp * (hm + hp));
+        double drift = b_ * S;
+
+        for (std::size_t k = 0; k < L; ++k)
+        {
+            std::size_t at = i * L + k;
+            double diffusion = 0.5 * sigma[k] * sigma[k] * S * S;
+            w.explicit_lower[at] = diffusion * d2_down + drift * d1_down;
+            w.explicit_diag[at] = diffusion * d2_mid + drift * d1_mid - r_;
+            w.explicit_upper[at] = diffusion * d2_up + drift * d1_up;
+            stiffness = std::max(stiffness, -w.explicit_diag[at]);
+        }
+    }
+
+    // Explicite au-delà de la limite de stabilité d'une option du bloc : implicite
+    if (theta == 0.0 && dt * stiffness > 1.0)
+        theta = 1.0;
+
+    // Systèmes (I - theta dt L) factorisés une fois, lignes 0 et M identité ;
+    // tableaux explicites ramenés à I + (1 - theta) dt L
+    w.c.assign(size * L, 0.0);
+    w.ratio.assign(size * L, 0.0);
+    w.inverse_pivot.assign(size * L, 1.0);
+    for (std::size_t at = L; at < M_ * L; ++at)
+    {
+        double lower = w.explicit_lower[at], diag = w.explicit_diag[at], upper = w.explicit_upper[at];
+        w.c[at] = -theta * dt * upper;
+        w.ratio[at] = -theta * dt * lower * w.inverse_pivot[at - L];
+        w.inverse_pivot[at] = 1.0 / (1.0 - theta * dt * diag - w.ratio[at] * w.c[at - L]);
+        w.explicit_lower[at] = (1.0 - theta) * dt * lower;
+        w.explicit_diag[at] = 1.0 + (1.0 - theta) * dt * diag;
+        w.explicit_upper[at] = (1.0 - theta) * dt * upper;
+    }
+
+    bool rannacher = (theta == 0.5 && rannacher_steps_ > 0);
+    std::size_t smoothing = rannacher ? rannacher_steps_ : 0;
+
+    double tau = 0.0;
+    auto step = [&]()
+    {
+        double* d = w.d.data();
+        double* x = w.next.data();
+        const double* obstacle = w.obstacle.data();
+        for (std::size_t k = 0; k < L; ++k)
+        {
+            d[k] = edge_value(*payoff[k], nodes[0], tau);
+            d[M_ * L + k] = edge_value(*payoff[k], nodes[M_], tau);
+        }
+
+        if (theta == 0.0)
+        {
+            std::copy(d, d + size * L, x);
+        }
+        else
+        {
+            // Substitutions avant et arrière, L systèmes à la fois
+            const double* ratio = w.ratio.data();
+            const double* inverse_pivot = w.inverse_pivot.data();
+            const double* c = w.c.data();
+            for (std::size_t k = 0; k < L; ++k)
+                x[k] = d[k];
+            for (std::size_t i = 1; i < size; ++i)
+                for (std::size_t k = 0; k < L; ++k)
+                    x[i * L + k] = d[i * L + k] - ratio[i * L + k] * x[(i - 1) * L + k];
+            for (std::size_t k = 0; k < L; ++k)
+                x[M_ * L + k] *= inverse_pivot[M_ * L + k];
+            for (std::size_t i = M_; i-- > 0;)
+                for (std::size_t k = 0; k < L; ++k)
+                    x[i * L + k] = (x[i * L + k] - c[i * L + k] * x[(i + 1) * L + k]) * inverse_pivot[i * L + k];
+        }
+
+        if (american)
+            for (std::size_t j = 0; j < size * L; ++j)
+                x[j] = std::max(x[j], obstacle[j]);
+    };
 
-    // Remonter dans le temps
     for (std::size_t n = N_; n-- > 0;)
     {
-        // Construire système tridiagonal
+        tau = T - static_cast<double>(n) * dt;
+
+        if (smoothing > 0)
+        {
+            // Bords au temps restant de chaque demi-pas
+            std::copy(w.grid.begin() + L, w.grid.end() - L, w.d.begin() + L);
+            tau -= 0.5 * dt;
+            step();
+            w.grid.swap(w.next);
+            std::copy(w.grid.begin() + L, w.grid.end() - L, w.d.begin() + L);
+            tau += 0.5 * dt;
+            step();
+            --smoothing;
+        }
+        else
+        {
+            const double* g = w.grid.data();
+            const double* el = w.explicit_lower.data();
+            const double* ed = w.explicit_diag.data();
+            const double* eu = w.explicit_upper.data();
+            double* d = w.d.data();
+            for (std::size_t j = L; j < M_ * L; ++j)
+                d[j] = el[j] * g[j - L] + ed[j] * g[j] + eu[j] * g[j + L];
+
+            step();
+        }
+
+        if (n == 1)
+            w.later = w.next;
+
+        w.grid.swap(w.next);
+    }
+
+    // Splines naturelles des tranches t = 0 et t = dt : matrice commune à
+    // toutes les options, factorisée une fois, seconds membres entrelacés
+    std::vector<double>& ratio = w.spline[0];
+    std::vector<double>& inverse_pivot = w.spline[1];
+    std::vector<double>& upper = w.spline[2];
+    ratio.assign(size, 0.0);
+    inverse_pivot.assign(size, 1.0);
+    upper.assign(size, 0.0);
+    for (std::size_t i = 1; i < M_; ++i)
+    {
+        double hm = nodes[i] - nodes[i - 1], hp = nodes[i + 1] - nodes[i];
+        upper[i] = hp / 6.0;
+        ratio[i] = hm / 6.0 * inverse_pivot[i - 1];
+        inverse_pivot[i] = 1.0 / ((hm + hp) / 3.0 - ratio[i] * upper[i - 1]);
+    }
+
+    auto fit = [&](const std::vector<double>& values, std::vector<double>& curvature)
+    {
+        curvature.assign(size * L, 0.0);
+        double* m = curvature.data();
+        const double* v = values.data();
         for (std::size_t i = 1; i < M_; ++i)
         {
-            double i_dbl = static_cast<double>(i);            
-            double alpha = 0.5 * dt * (sigma_ * sigma_ * i_dbl * i_dbl - b_ * i_dbl / dS);
-            double beta = -dt * (sigma_ * sigma_ * i_dbl * i_dbl + r_);
-            double gamma = 0.5 * dt * (sigma_ * sigma_ * i_dbl * i_dbl + b_ * i_dbl / dS);
-
-            a[i] = alpha;
-            b[i] = 1.0 - beta;
-            c[i] = gamma;
-            d[i] = grid[i];
+            double hm = nodes[i] - nodes[i - 1], hp = nodes[i + 1] - nodes[i];
+            for (std::size_t k = 0; k < L; ++k)
+                m[i * L + k] = (v[(i + 1) * L + k] - v[i * L + k]) / hp - (v[i * L + k] - v[(i - 1) * L + k]) / hm
+                             - ratio[i] * m[(i - 1) * L + k];
         }
+        for (std::size_t i = M_; i-- > 1;)
+            for (std::size_t k = 0; k < L; ++k)
+                m[i * L + k] = (m[i * L + k] - upper[i] * m[(i + 1) * L + k]) * inverse_pivot[i];
+    };
+    fit(w.grid, w.spline[3]);
+    fit(w.later, w.spline[4]);
+
+    // Polynôme cubique de l'intervalle contenant S0 (comme evaluate_spline)
+    std::size_t j = static_cast<std::size_t>(std::upper_bound(w.nodes.begin(), w.nodes.end(), S0_) - w.nodes.begin());
+    j = std::clamp<std::size_t>(j, 1, M_);
+    double h = nodes[j] - nodes[j - 1];
+    double A = (nodes[j] - S0_) / h, B = (S0_ - nodes[j - 1]) / h;
+
+    for (std::size_t k = 0; k < used; ++k)
+    {
+        std::size_t low = (j - 1) * L + k, high = j * L + k;
+        auto value = [&](const std::vector<double>& v, const std::vector<double>& m)
+        {
+            return A * v[low] + B * v[high] + ((A * A * A - A) * m[low] + (B * B * B - B) * m[high]) * h * h / 6.0;
+        };
+
+        const double* v = w.grid.data();
+        const double* m = w.spline[3].data();
+        greeks[k].price = value(w.grid, w.spline[3]);
+        greeks[k].delta = (v[high] - v[low]) / h - (3.0 * A * A - 1.0) / 6.0 * h * m[low]
+                        + (3.0 * B * B - 1.0) / 6.0 * h * m[high];
+        greeks[k].gamma = A * m[low] + B * m[high];
+        greeks[k].theta = (value(w.later, w.spline[4]) - greeks[k].price) / dt;
+    }
+}
 
-        // Conditions aux bords
-        b[0] = 1.0;
-        c[0] = 0.0;
-        d[0] = option_.payoff().payoff_spot(0.0);
+/* =========================================================
+   GRILLE, OPÉRATEUR ET INTERPOLATION
+   ========================================================= */
 
-        a[M_] = 0.0;
-        b[M_] = 1.0;
-        d[M_] = option_.payoff().payoff_spot(Smax_);
+void FiniteDifferenceAmericanPricer::set_grid(Grid grid, double concentration)
+{
+    if (concentration <= 0.0)
+        throw std::invalid_argument("Grid concentration must be positive");
 
-        // Résoudre système
-        solve_tridiagonal(a, b, c, d, newGrid);
+    grid_ = grid;
+    concentration_ = concentration;
+    solved_ = false;
+}
 
-        // Contrainte américaine
+void FiniteDifferenceAmericanPricer::spot_grid(std::vector<double>& nodes, bool knock_out) const
+{
+    nodes.resize(M_ + 1);
+
+    // Surveillance continue : la barrière est le nœud de bord du domaine vivant
+    bool truncate = knock_out && monitoring_dates_.empty();
+    bool up = barrier_ && barrier_->direction() == BarrierPayoff::Direction::Up;
+    double B = barrier_ ? barrier_->barrier() : 0.0;
+
+    if (grid_ == Grid::Uniform)
+    {
+        double lower = 0.0, upper = barrier_ ? std::max(Smax_, kBarrierMargin * B) : Smax_;
+        if (truncate)
+            (up ? upper : lower) = B;
+
+        // Surveillance discrète : pas B / k, la barrière est le nœud k (borne
+        // haute légèrement élargie)
+        double dS = (upper - lower) / static_cast<double>(M_);
+        double barrier_steps = std::max(1.0, std::floor(B / dS));
+        if (barrier_ && !truncate)
+            dS = B / barrier_steps;
         for (std::size_t i = 0; i <= M_; ++i)
+            nodes[i] = lower + static_cast<double>(i) * dS;
+
+        // Barrière exacte (k dS peut s'en écarter d'un ulp, apply_knock_out
+        // compare à B exactement)
+        if (truncate)
+            (up ? nodes[M_] : nodes[0]) = B;
+        else if (barrier_ && barrier_steps <= static_cast<double>(M_))
+            nodes[static_cast<std::size_t>(barrier_steps)] = B;
+    }
+    else
+    {
+        log_spot_grid(nodes, truncate);
+    }
+}
+
+void FiniteDifferenceAmericanPricer::log_spot_grid(std::vector<double>& nodes, bool truncate) const
+{
+    // Bornes en log S : ±kDomainWidth sigma sqrt(T) autour de S0 et de K,
+    // étendues à la barrière ou coupées à la barrière (domaine tronqué)
+    double K = option_.payoff().strike();
+    double x_spot = std::log(S0_);
+    double x_strike = (K > 0.0) ? std::log(K) : x_spot;
+    double width = sigma_ * std::sqrt(option_.maturity());
+    double lo = std::min(x_spot, x_strike) - kDomainWidth * width;
+    double hi = std::max(x_spot, x_strike) + kDomainWidth * width;
+
+    if (barrier_)
+    {
+        double x_barrier = std::log(barrier_->barrier());
+        bool up = barrier_->direction() == BarrierPayoff::Direction::Up;
+        if (truncate && up)
+        {
+            hi = x_barrier;
+            lo = std::min(lo, hi - width);
+        }
+        else if (truncate)
+        {
+            lo = x_barrier;
+            hi = std::max(hi, lo + width);
+        }
+        else
         {
-            double S = static_cast<double>(i) * dS;
-            newGrid[i] = std::max(newGrid[i], option_.payoff().payoff_spot(S));
+            lo = std::min(lo, x_barrier - width);
+            hi = std::max(hi, x_barrier + width);
         }
+    }
+
+    // Transformation sinh à deux centres : densité de nœuds en
+    // 1 / sqrt(alpha² + (x - c)²) autour de K et de S0, primitive J en asinh
+    double alpha = concentration_ * width;
+    auto J = [&](double x)
+    {
+        return std::asinh((x - x_strike) / alpha) + std::asinh((x - x_spot) / alpha);
+    };
+    double J_lo = J(lo), J_hi = J(hi);
+    double level = (J_hi - J_lo) / static_cast<double>(M_);
 
-        grid.swap(newGrid);
+    // Surveillance discrète : pas des niveaux ajusté pour que la barrière soit
+    // le niveau k, sans rompre la régularité de la grille (borne haute déplacée)
+    std::size_t barrier_node = 0;
+    if (barrier_ && !truncate)
+    {
+        double J_barrier = J(std::log(barrier_->barrier()));
+        barrier_node = static_cast<std::size_t>(std::clamp<long>(std::lround((J_barrier - J_lo) / level), 1, static_cast<long>(M_) - 1));
+        level = (J_barrier - J_lo) / static_cast<double>(barrier_node);
     }
 
-    std::size_t i = static_cast<std::size_t>(S0_ / dS);
-    double w = (S0_ - static_cast<double>(i) * dS) / dS;
-    return (1.0 - w) * grid[i] + w * grid[i + 1];
+    nodes[0] = std::exp(lo);
+    nodes[M_] = std::exp(hi);
+    double x = lo;
+    for (std::size_t i = 1; i <= M_; ++i)
+    {
+        // Borne haute fixée, sauf si le pas des niveaux a été ajusté
+        if (i == M_ && barrier_node == 0)
+            break;
+
+        // J(x_i) = J_lo + i level : Newton depuis le nœud précédent
+        // (J croissante et concave au-delà des centres), bissection de secours
+        double target = J_lo + static_cast<double>(i) * level;
+        double left = x, right = hi + (hi - lo);
+        for (int k = 0; k < 100; ++k)
+        {
+            double f = J(x) - target;
+            if (std::fabs(f) < 1e-14)
+                break;
+            (f < 0.0 ? left : right) = x;
+
+            double slope = 1.0 / std::sqrt(alpha * alpha + (x - x_strike) * (x - x_strike))
+                         + 1.0 / std::sqrt(alpha * alpha + (x - x_spot) * (x - x_spot));
+            double next = x - f / slope;
+            x = (next > left && next < right) ? next : 0.5 * (left + right);
+        }
+        nodes[i] = std::exp(x);
+    }
+
+    // Barrière exacte au bord du domaine tronqué ou sur son nœud
+    if (truncate)
+        (barrier_->direction() == BarrierPayoff::Direction::Up ? nodes[M_] : nodes[0]) = barrier_->barrier();
+    if (barrier_node > 0)
+        nodes[barrier_node] = barrier_->barrier();
+}
+
+double FiniteDifferenceAmericanPricer::edge_value(double S, double tau, bool at_barrier) const
+{
+    if (at_barrier)
+        return rebate_;
+    return edge_value(option_.payoff(), S, tau);
+}
+
+double FiniteDifferenceAmericanPricer::edge_value(const Payoff& payoff, double S, double tau) const
+{
+    // Américain : exercice au bord ; européen : valeur intrinsèque actualisée
+    // (asymptote de Black-Scholes loin du strike)
+    if (exercise_ == Exercise::American)
+        return payoff.payoff_spot(S);
+
+    double forward = S * std::exp((b_ - r_) * tau);
+    double strike = payoff.strike() * std::exp(-r_ * tau);
+    return std::max(payoff.type() == OptionType::Call ? forward - strike : strike - forward, 0.0);
 }
 
-// Crank-Nicolson
-double FiniteDifferenceAmericanPricer::price_crank_nicolson() const
+void FiniteDifferenceAmericanPricer::time_grid(std::vector<double>& times) const
 {
+    // Temps restant tau = T g(u), u = (N - n) / N : g(u) = u (uniforme), ou
+    // g(u) = (1 - w) u + w u² (pas fins près de la maturité, où est le coude
+    // du payoff, puis jusqu'à (1 + w) T / N)
     double T = option_.maturity();
-    double dS = Smax_ / static_cast<double>(M_);
-    double dt = T / static_cast<double>(N_);
+    times.resize(N_ + 1);
+    for (std::size_t n = 0; n <= N_; ++n)
+    {
+        double u = static_cast<double>(N_ - n) / static_cast<double>(N_);
+        times[n] = graded_ ? T - T * ((1.0 - kTimeGrading) * u + kTimeGrading * u * u)
+                           : static_cast<double>(n) * (T / static_cast<double>(N_));
+    }
+    times[N_] = T;
+
+    // Dates ex et de surveillance : nœuds exacts, insérés entre deux pas
+    // (l'erreur ne dépend plus de la position des dates dans la grille)
+    std::vector<double> events;
+    for (const CashDividend& dividend : dividends_.dividends())
+        if (dividend.time < T)
+            events.push_back(dividend.time);
+    if (barrier_)
+        events.insert(events.end(), monitoring_dates_.begin(), monitoring_dates_.end());
+
+    double tolerance = 1e-10 * T;
+    for (double t : events)
+    {
+        auto next = std::lower_bound(times.begin(), times.end(), t);
+        if (next != times.end() && *next - t <= tolerance)
+            continue;
+        if (next != times.begin() && t - *(next - 1) <= tolerance)
+            continue;
+        times.insert(next, t);
+    }
+}
+
+std::size_t FiniteDifferenceAmericanPricer::nearest_step(const std::vector<double>& times, double t) const
+{
+    std::size_t j = static_cast<std::size_t>(std::upper_bound(times.begin(), times.end(), t) - times.begin());
+    if (j == 0)
+        return 0;
+    if (j >= times.size())
+        return times.size() - 1;
+    return (t - times[j - 1] < times[j] - t) ? j - 1 : j;
+}
+
+void FiniteDifferenceAmericanPricer::build_operator(const std::vector<double>& nodes,
+                                                    std::vector<double>& lower,
+                                                    std::vector<double>& diag,
+                                                    std::vector<double>& upper) const
+{
+    lower.assign(M_ + 1, 0.0);
+    diag.assign(M_ + 1, 0.0);
+    upper.assign(M_ + 1, 0.0);
+
+    bool log_grid = (grid_ == Grid::LogSpot);
+    for (std::size_t i = 1; i < M_; ++i)
+    {
+        // Coordonnée y (S ou log S), diffusion et drift de l'EDP en y
+        double y_down = log_grid ? std::log(nodes[i - 1]) : nodes[i - 1];
+        double y = log_grid ? std::log(nodes[i]) : nodes[i];
+        double y_up = log_grid ? std::log(nodes[i + 1]) : nodes[i + 1];
+
+        double S = nodes[i];
+        double diffusion = log_grid ? 0.5 * sigma_ * sigma_ : 0.5 * sigma_ * sigma_ * S * S;
+        double drift = log_grid ? b_ - 0.5 * sigma_ * sigma_ : b_ * S;
+
+        // Différences centrées sur pas h- et h+ (exactes pour les quadratiques)
+        double hm = y - y_down, hp = y_up - y;
+        double d1_down = -hp / (hm * (hm + hp)), d1_mid = (hp - hm) / (hm * hp), d1_up = hm / (hp * (hm + hp));
+        double d2_down = 2.0 / (hm * (hm + hp)), d2_mid = -2.0 / (hm * hp), d2_up = 2.0 / (hp * (hm + hp));
+
+        lower[i] = diffusion * d2_down + drift * d1_down;
+        diag[i] = diffusion * d2_mid + drift * d1_mid - r_;
+        upper[i] = diffusion * d2_up + drift * d1_up;
+    }
+}
+
+void FiniteDifferenceAmericanPricer::fit_spline(const std::vector<double>& nodes,
+                                                const std::vector<double>& values,
+                                                std::vector<double>& curvature) const
+{
+    // Spline dans la coordonnée de la grille (S ou log S)
+    bool log_grid = (grid_ == Grid::LogSpot);
 
-    std::vector<double> grid(M_ + 1), newGrid(M_ + 1);
+    // Dérivées secondes de la spline naturelle (système tridiagonal)
+    Workspace& w = workspace();
+    std::vector<double>& y = w.spline[0];
+    std::vector<double>& a = w.spline[1];
+    std::vector<double>& b = w.spline[2];
+    std::vector<double>& c = w.spline[3];
+    std::vector<double>& d = w.spline[4];
 
-    // Condition terminale
+    y.resize(M_ + 1);
     for (std::size_t i = 0; i <= M_; ++i)
-        grid[i] = option_.payoff().payoff_spot(static_cast<double>(i) * dS);
+        y[i] = log_grid ? std::log(nodes[i]) : nodes[i];
 
-    std::vector<double> a(M_ + 1), b(M_ + 1), c(M_ + 1), d(M_ + 1);
+    a.assign(M_ + 1, 0.0);
+    b.assign(M_ + 1, 1.0);
+    c.assign(M_ + 1, 0.0);
+    d.assign(M_ + 1, 0.0);
+    curvature.resize(M_ + 1);
+    for (std::size_t i = 1; i < M_; ++i)
+    {
+        double hm = y[i] - y[i - 1], hp = y[i + 1] - y[i];
+        a[i] = hm / 6.0;
+        b[i] = (hm + hp) / 3.0;
+        c[i] = hp / 6.0;
+        d[i] = (values[i + 1] - values[i]) / hp - (values[i] - values[i - 1]) / hm;
+    }
+    solve_tridiagonal(a, b, c, d, curvature, w.scratch);
+}
 
-    // Remonter dans le temps
-    for (std::size_t n = N_; n-- > 0;)
+void FiniteDifferenceAmericanPricer::evaluate_spline(const std::vector<double>& nodes,
+                                                     const std::vector<double>& values,
+                                                     const std::vector<double>& curvature,
+                                                     double spot,
+                                                     double& value,
+                                                     double& delta,
+                                                     double& gamma) const
+{
+    if (spot < nodes.front() || spot > nodes.back())
+        throw std::invalid_argument("Spot outside the finite difference grid");
+
+    bool log_grid = (grid_ == Grid::LogSpot);
+    auto coordinate = [&](double S) { return log_grid ? std::log(S) : S; };
+
+    std::size_t j = static_cast<std::size_t>(std::upper_bound(nodes.begin(), nodes.end(), spot) - nodes.begin());
+    j = std::clamp<std::size_t>(j, 1, M_);
+
+    // Polynôme cubique sur [y_(j-1), y_j] et ses deux dérivées en y
+    double y_low = coordinate(nodes[j - 1]), y_high = coordinate(nodes[j]), y = coordinate(spot);
+    double h = y_high - y_low;
+    double A = (y_high - y) / h, B = (y - y_low) / h;
+    const double* m = curvature.data();
+
+    value = A * values[j - 1] + B * values[j]
+          + ((A * A * A - A) * m[j - 1] + (B * B * B - B) * m[j]) * h * h / 6.0;
+    double first = (values[j] - values[j - 1]) / h
+                 - (3.0 * A * A - 1.0) / 6.0 * h * m[j - 1]
+                 + (3.0 * B * B - 1.0) / 6.0 * h * m[j];
+    double second = A * m[j - 1] + B * m[j];
+
+    // En log S : V_S = V_x / S, V_SS = (V_xx - V_x) / S²
+    delta = log_grid ? first / spot : first;
+    gamma = log_grid ? (second - first) / (spot * spot) : second;
+}
+
+/* =========================================================
+   FRONTIÈRE D'EXERCICE ANTICIPÉ
+   ========================================================= */
+
+ExerciseBoundary FiniteDifferenceAmericanPricer::exercise_boundary() const
+{
+    if (!dividends_.empty())
+        throw std::invalid_argument("Exercise boundary assumes a continuous carry (no discrete dividends)");
+    if (barrier_ || exercise_ != Exercise::American)
+        throw std::invalid_argument("Exercise boundary needs an American vanilla option");
+
+    // Erreur contrôlée : frontière de la grille la plus fine
+    if (tolerance_ > 0.0)
     {
-        // Crank-Nicolson : moyenne entre explicite et implicite
-        for (std::size_t i = 1; i < M_; ++i)
+        ensure_solved();
+        return fine_level_->exercise_boundary();
+    }
+
+    OptionType type = option_.payoff().type();
+    double K = option_.payoff().strike();
+    double T = option_.maturity();
+
+    // Un point par pas de temps, relevé après la contrainte américaine
+    std::vector<double> times;
+    time_grid(times);
+    std::size_t steps = times.size() - 1;
+    std::vector<double> critical(1, ExerciseBoundary::expiry_limit(type, K, r_, b_));
+    critical.reserve(steps + 1);
+
+    Solution solution;
+    solve(solution, false, &critical);
+
+    std::vector<double> tau(steps + 1);
+    for (std::size_t n = 0; n <= steps; ++n)
+        tau[n] = T - times[steps - n];
+
+    return ExerciseBoundary(type, K, r_, b_, sigma_, std::move(tau), std::move(critical));
+}
+
+void FiniteDifferenceAmericanPricer::record_boundary(const std::vector<double>& values,
+                                                     const std::vector<double>& nodes,
+                                                     std::vector<double>& boundary) const
+{
+    // Les bords 0 et M portent les conditions aux limites, pas la décision d'exercice
+    boundary.push_back(ExerciseBoundary::critical_from_slice(option_.payoff().type(),
+                                                             option_.payoff().strike(),
+                                                             nodes.data() + 1, values.data() + 1, M_ - 1));
+}
+
+/* =========================================================
+   DIVIDENDES DISCRETS
+   ========================================================= */
+
+void FiniteDifferenceAmericanPricer::dividend_steps(const std::vector<double>& times, std::vector<double>& amounts) const
+{
+    // Dates ex sur leur nœud (time_grid) ; celles au-delà de la maturité sont ignorées
+    amounts.assign(times.size(), 0.0);
+    for (const CashDividend& dividend : dividends_.dividends())
+    {
+        if (dividend.time >= option_.maturity())
+            continue;
+        amounts[nearest_step(times, dividend.time)] += dividend.amount;
+    }
+}
+
+void FiniteDifferenceAmericanPricer::apply_dividend(std::vector<double>& values,
+                                                    const std::vector<double>& nodes,
+                                                    const std::vector<double>& obstacle,
+                                                    double amount) const
+{
+    // V(S_i) lit la tranche en S_i - D <= S_i : parcours décroissant, en place.
+    // Sous le premier nœud, la valeur du bord
+    bool american = (exercise_ == Exercise::American);
+    for (std::size_t i = M_ + 1; i-- > 0;)
+    {
+        double S = std::max(nodes[i] - amount, nodes[0]);
+        std::size_t j = static_cast<std::size_t>(std::upper_bound(nodes.begin(), nodes.begin() + i + 1, S) - nodes.begin());
+        j = std::clamp<std::size_t>(j, 1, M_);
+        double w = (S - nodes[j - 1]) / (nodes[j] - nodes[j - 1]);
+
+        double value = (1.0 - w) * values[j - 1] + w * values[j];
+        values[i] = american ? std::max(value, obstacle[i]) : value;
+    }
+}
+
+/* =========================================================
+   BARRIÈRES
+   ========================================================= */
+
+void FiniteDifferenceAmericanPricer::set_monitoring_dates(std::vector<double> dates)
+{
+    if (!barrier_ && !dates.empty())
+        throw std::invalid_argument("Monitoring dates need a barrier payoff");
+    for (double date : dates)
+        if (date < 0.0 || date > option_.maturity())
+            throw std::invalid_argument("Monitoring dates must lie in [0, maturity]");
+
+    std::sort(dates.begin(), dates.end());
+    monitoring_dates_ = std::move(dates);
+    solved_ = false;
+}
+
+void FiniteDifferenceAmericanPricer::set_rebate(double rebate)
+{
+    if (rebate < 0.0)
+        throw std::invalid_argument("Rebate must be non-negative");
+
+    rebate_ = rebate;
+    solved_ = false;
+}
+
+void FiniteDifferenceAmericanPricer::monitoring_steps(const std::vector<double>& times, std::vector<char>& monitored) const
+{
+    // Dates sur leur nœud (time_grid), comme les dates ex
+    monitored.assign(times.size(), 0);
+    for (double date : monitoring_dates_)
+        monitored[nearest_step(times, date)] = 1;
+}
+
+void FiniteDifferenceAmericanPricer::apply_knock_out(std::vector<double>& values, const std::vector<double>& nodes) const
+{
+    // Nœuds au-delà de la barrière : l'option s'éteint, rebate versé. Le nœud
+    // de la barrière porte la discontinuité : moyenne des deux limites, sans
+    // quoi la barrière effective recule d'un demi-pas
+    double B = barrier_->barrier();
+    for (std::size_t i = 0; i <= M_; ++i)
+    {
+        if (nodes[i] == B)
+            values[i] = 0.5 * (values[i] + rebate_);
+        else if (barrier_->is_breached(nodes[i]))
+            values[i] = rebate_;
+    }
+}
+
+/* =========================================================
+   CONTRAINTE AMÉRICAINE (PROBLÈME DE COMPLÉMENTARITÉ)
+   ========================================================= */
+
+void FiniteDifferenceAmericanPricer::set_constraint(Constraint constraint)
+{
+    constraint_ = constraint;
+    solved_ = false;
+}
+
+void FiniteDifferenceAmericanPricer::factorize(Workspace& w) const
+{
+    // Élimination de Gauss de (a, b, c), une fois par résolution. Brennan-Schwartz
+    // élimine depuis le côté de continuation : du haut pour un put
+    std::size_t n = w.b.size();
+    w.ratio.resize(n);
+    w.inverse_pivot.resize(n);
+    w.from_top = (constraint_ == Constraint::BrennanSchwartz && option_.payoff().type() == OptionType::Put);
+
+    if (w.from_top)
+    {
+        // x_i = (rhs_i - a_i x_(i-1)) / pivot_i, rhs_i = d_i - ratio_i rhs_(i+1)
+        double pivot = w.b[n - 1];
+        w.ratio[n - 1] = 0.0;
+        w.inverse_pivot[n - 1] = 1.0 / pivot;
+        for (std::size_t i = n - 1; i-- > 0;)
         {
-            double i_dbl = static_cast<double>(i);            
-            double alpha = 0.25 * dt * (sigma_ * sigma_ * i_dbl * i_dbl - b_ * i_dbl / dS);
-            double beta = -0.5 * dt * (sigma_ * sigma_ * i_dbl * i_dbl + r_);
-            double gamma = 0.25 * dt * (sigma_ * sigma_ * i_dbl * i_dbl + b_ * i_dbl / dS);
-
-            // Partie implicite 
-            a[i] = -alpha;
-            b[i] = 1.0 - beta;
-            c[i] = -gamma;
-
-            // Partie explicite
-            d[i] = alpha * grid[i - 1] + (1.0 + beta) * grid[i] + gamma * grid[i + 1];
+            w.ratio[i] = w.c[i] / pivot;
+            pivot = w.b[i] - w.ratio[i] * w.a[i + 1];
+            w.inverse_pivot[i] = 1.0 / pivot;
         }
+    }
+    else
+    {
+        // Thomas : x_i = (rhs_i - c_i x_(i+1)) / pivot_i, rhs_i = d_i - ratio_i rhs_(i-1)
+        double pivot = w.b[0];
+        w.ratio[0] = 0.0;
+        w.inverse_pivot[0] = 1.0 / pivot;
+        for (std::size_t i = 1; i < n; ++i)
+        {
+            w.ratio[i] = w.a[i] / pivot;
+            pivot = w.b[i] - w.ratio[i] * w.c[i - 1];
+            w.inverse_pivot[i] = 1.0 / pivot;
+        }
+    }
 
-        // Conditions aux bords
-        b[0] = 1.0;
-        c[0] = 0.0;
-        d[0] = option_.payoff().payoff_spot(0.0);
+    // PSOR : relaxation optimale de Young, omega = 2 / (1 + sqrt(1 - rho²)),
+    // rayon spectral de Jacobi estimé comme pour une matrice tridiagonale
+    // constante (2 sqrt(a c) / b cos(pi / n)). Sur une grille fine, rho -> 1
+    // et un omega fixe converge très lentement
+    double rho = 0.0;
+    for (std::size_t i = 1; i + 1 < n; ++i)
+        if (w.a[i] * w.c[i] > 0.0)
+            rho = std::max(rho, 2.0 * std::sqrt(w.a[i] * w.c[i]) / std::fabs(w.b[i]));
+    rho = std::min(rho * std::cos(std::acos(-1.0) / static_cast<double>(n)), 1.0);
+    w.relaxation = std::clamp(2.0 / (1.0 + std::sqrt(1.0 - rho * rho)), 1.0, kPsorMaxRelaxation);
+}
 
-        a[M_] = 0.0;
-        b[M_] = 1.0;
-        d[M_] = option_.payoff().payoff_spot(Smax_);
+void FiniteDifferenceAmericanPricer::substitute(const Workspace& w, const double* obstacle, double* x) const
+{
+    // Substitutions avant et arrière sur la factorisation, en place dans x.
+    // obstacle non nul : max(x_i, g_i) dans la substitution (Brennan-Schwartz)
+    std::size_t n = w.d.size();
+    const double* d = w.d.data();
+    const double* ratio = w.ratio.data();
+    const double* inverse_pivot = w.inverse_pivot.data();
 
-        // Résoudre système
-        solve_tridiagonal(a, b, c, d, newGrid);
+    if (w.from_top)
+    {
+        const double* a = w.a.data();
+        x[n - 1] = d[n - 1];
+        for (std::size_t i = n - 1; i-- > 0;)
+            x[i] = d[i] - ratio[i] * x[i + 1];
 
-        // Contrainte américaine
+        x[0] *= inverse_pivot[0];
+        if (obstacle)
+            x[0] = std::max(x[0], obstacle[0]);
+        for (std::size_t i = 1; i < n; ++i)
+        {
+            x[i] = (x[i] - a[i] * x[i - 1]) * inverse_pivot[i];
+            if (obstacle)
+                x[i] = std::max(x[i], obstacle[i]);
+        }
+    }
+    else
+    {
+        const double* c = w.c.data();
+        x[0] = d[0];
+        for (std::size_t i = 1; i < n; ++i)
+            x[i] = d[i] - ratio[i] * x[i - 1];
+
+        x[n - 1] *= inverse_pivot[n - 1];
+        if (obstacle)
+            x[n - 1] = std::max(x[n - 1], obstacle[n - 1]);
+        for (std::size_t i = n - 1; i-- > 0;)
+        {
+            x[i] = (x[i] - c[i] * x[i + 1]) * inverse_pivot[i];
+            if (obstacle)
+                x[i] = std::max(x[i], obstacle[i]);
+        }
+    }
+}
+
+void FiniteDifferenceAmericanPricer::solve_constrained(Workspace& w) const
+{
+    // A x >= d, x >= g, (A x - d)_i (x - g)_i = 0 (A tridiagonal (a, b, c)).
+    // Départ des méthodes itératives : la tranche du pas précédent (w.grid)
+    switch (constraint_)
+    {
+    case Constraint::Projection:
+        substitute(w, nullptr, w.next.data());
         for (std::size_t i = 0; i <= M_; ++i)
+            w.next[i] = std::max(w.next[i], w.obstacle[i]);
+        break;
+    case Constraint::BrennanSchwartz:
+        // Zone d'exercice au bord de départ de la substitution (put en bas, call en haut)
+        substitute(w, w.obstacle.data(), w.next.data());
+        break;
+    case Constraint::PSOR:
+        solve_psor(w);
+        break;
+    case Constraint::PolicyIteration:
+        solve_policy_iteration(w);
+        break;
+    default:
+        throw std::runtime_error("Unknown American constraint");
+    }
+}
+
+void FiniteDifferenceAmericanPricer::solve_psor(Workspace& w) const
+{
+    // Gauss-Seidel sur-relaxé projeté, démarré de la solution du pas précédent
+    std::size_t n = w.d.size();
+    const double* a = w.a.data();
+    const double* b = w.b.data();
+    const double* c = w.c.data();
+    const double* d = w.d.data();
+    const double* obstacle = w.obstacle.data();
+    double omega = w.relaxation;
+
+    w.next = w.grid;
+    double* x = w.next.data();
+
+    for (std::size_t k = 0; k < kPsorMaxIterations; ++k)
+    {
+        double change = 0.0;
+        for (std::size_t i = 0; i < n; ++i)
         {
-            double S = static_cast<double>(i) * dS;
-            newGrid[i] = std::max(newGrid[i], option_.payoff().payoff_spot(S));
+            double sum = d[i];
+            if (i > 0)
+                sum -= a[i] * x[i - 1];
+            if (i + 1 < n)
+                sum -= c[i] * x[i + 1];
+
+            double gs = sum / b[i];
+            double next = std::max(x[i] + omega * (gs - x[i]), obstacle[i]);
+            change = std::max(change, std::fabs(next - x[i]));
+            x[i] = next;
         }
 
-        grid.swap(newGrid);
+        if (change < kPsorTolerance)
+            return;
     }
 
-    std::size_t i = static_cast<std::size_t>(S0_ / dS);
-    double w = (S0_ - static_cast<double>(i) * dS) / dS;
-    return (1.0 - w) * grid[i] + w * grid[i + 1];
+    throw std::runtime_error("PSOR did not converge (reduce the time step)");
 }
 
-double FiniteDifferenceAmericanPricer::delta(double spot) const
+void FiniteDifferenceAmericanPricer::solve_policy_iteration(Workspace& w) const
 {
-    double h = 1e-4 * spot;
+    // Howard : min(A x - d, x - g) = 0. Chaque ligne suit la politique de plus
+    // petit résidu (ligne de l'EDP ou x_i = g_i), puis un solve tridiagonal.
+    // La politique initiale vient du pas précédent ; convergence en quelques
+    // itérations (suite monotone, nombre fini de politiques). Les lignes
+    // changent : factorisation à chaque itération
+    std::size_t n = w.d.size();
+    std::vector<double>& pa = w.policy_system[0];
+    std::vector<double>& pb = w.policy_system[1];
+    std::vector<double>& pc = w.policy_system[2];
+    std::vector<double>& pd = w.policy_system[3];
+    pa.resize(n);
+    pb.resize(n);
+    pc.resize(n);
+    pd.resize(n);
+    w.exercised.assign(n, 0);
+    w.previous.assign(n, 0);
+
+    std::vector<double>& x = w.next;
+    x = w.grid;
+    for (std::size_t k = 0; k <= n; ++k)
+    {
+        bool changed = false;
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            double pde = w.b[i] * x[i] - w.d[i];
+            if (i > 0)
+                pde += w.a[i] * x[i - 1];
+            if (i + 1 < n)
+                pde += w.c[i] * x[i + 1];
 
-    FiniteDifferenceAmericanPricer up(option_, spot + h, r_, b_, sigma_, M_, N_, scheme_);
-    FiniteDifferenceAmericanPricer down(option_, spot - h, r_, b_, sigma_, M_, N_, scheme_);
+            char exercised = (x[i] - w.obstacle[i] < pde) ? 1 : 0;
+            changed = changed || exercised != w.previous[i];
+            w.exercised[i] = exercised;
 
-    return (up.price() - down.price()) / (2.0 * h);
+            // Ligne active : x_i = g_i, sinon la ligne de l'EDP
+            pa[i] = exercised ? 0.0 : w.a[i];
+            pb[i] = exercised ? 1.0 : w.b[i];
+            pc[i] = exercised ? 0.0 : w.c[i];
+            pd[i] = exercised ? w.obstacle[i] : w.d[i];
+        }
+
+        if (k > 0 && !changed)
+            return;
+
+        solve_tridiagonal(pa, pb, pc, pd, x, w.scratch);
+        w.previous.swap(w.exercised);
+    }
+
+    throw std::runtime_error("Policy iteration did not converge");
 }
 
 /* =========================================================
@@ -235,25 +1419,25 @@ void FiniteDifferenceAmericanPricer::solve_tridiagonal(
     const std::vector<double>& b,
     const std::vector<double>& c,
     const std::vector<double>& d,
-    std::vector<double>& x) const
+    std::vector<double>& x,
+    std::vector<double>& c_prime) const
 {
+    // Sans allocation : d' est construit dans x, c' dans le tampon fourni
     std::size_t n = d.size();
-    std::vector<double> c_prime(n);
-    std::vector<double> d_prime(n);
+    c_prime.resize(n);
 
     // Forward sweep
     c_prime[0] = c[0] / b[0];
-    d_prime[0] = d[0] / b[0];
+    x[0] = d[0] / b[0];
 
     for (std::size_t i = 1; i < n; ++i)
     {
         double m = 1.0 / (b[i] - a[i] * c_prime[i - 1]);
         c_prime[i] = c[i] * m;
-        d_prime[i] = (d[i] - a[i] * d_prime[i - 1]) * m;
+        x[i] = (d[i] - a[i] * x[i - 1]) * m;
     }
 
     // Back substitution
-    x[n - 1] = d_prime[n - 1];
     for (std::size_t i = n - 1; i-- > 0;)
-        x[i] = d_prime[i] - c_prime[i] * x[i + 1];
-}
\ No newline at end of file
+        x[i] -= c_prime[i] * x[i + 1];
+}
@@ -2,7 +2,30 @@
 
 #include "pricer.hpp"
 #include "option.hpp"
+#include "exercise_boundary.hpp"
+#include "dividend_schedule.hpp"
 #include <vector>
+#include <memory>
+
+/* =========================================================
+   PRIX ET GREEKS D'UNE SEULE RÉSOLUTION
+   ========================================================= */
+struct GridGreeks
+{
+    double price;
+    double delta;
+    double gamma;
+    double theta;
+};
+
+// Profil V(S) à t = 0 relu sur la solution (spline cubique)
+struct PriceProfile
+{
+    std::vector<double> spots;
+    std::vector<double> prices;
+    std::vector<double> deltas;
+    std::vector<double> gammas;
+};
 
 /* =========================================================
    DIFFÉRENCES FINIES – OPTION AMÉRICAINE
@@ -12,11 +35,33 @@ class FiniteDifferenceAmericanPricer : public Pricer
 public:
     enum class Scheme
     {
-        Explicit,      // Schéma explicite 
+        Explicit,      // Schéma explicite (pas implicite au-delà de la limite de stabilité dt max |diag L| <= 1)
         Implicit,      // Schéma implicite
         CrankNicolson  // Crank-Nicolson
     };
 
+    // Grille en espace
+    enum class Grid
+    {
+        Uniform,  // Uniforme en S sur [0, 3 S0]
+        LogSpot   // En log S, bornes à ±kDomainWidth sigma sqrt(T), nœuds concentrés (sinh) sur K et S0
+    };
+
+    // Contrainte américaine des schémas implicite et Crank-Nicolson
+    enum class Constraint
+    {
+        Projection,       // Solve sans contrainte puis max(V, payoff) (premier ordre en temps)
+        BrennanSchwartz,  // Solve direct de l'LCP (zone d'exercice d'un seul côté)
+        PSOR,             // SOR projeté, démarré du pas précédent
+        PolicyIteration   // Itération de politique (Howard) : solves tridiagonaux exacts
+    };
+
+    enum class Exercise
+    {
+        European,  // Sans contrainte, bords actualisés
+        American
+    };
+
     FiniteDifferenceAmericanPricer(const Option& option,
                                    double spot,
                                    double rate,
@@ -27,24 +72,266 @@ public:
                                    Scheme scheme = Scheme::CrankNicolson);
 
     double price() const override;
+
+    // Greeks lus sur la grille de la résolution en cache (spline cubique en
+    // espace, tranche t = dt pour theta) : aucune résolution supplémentaire.
+    // Le spot doit rester dans la grille construite autour de S0
     double delta(double spot) const override;
+    double gamma(double spot) const override;
+    double theta() const override;
+
+    // Prix, delta, gamma et theta en S0 d'une seule résolution
+    GridGreeks price_and_greeks() const;
+
+    // Prix, deltas et gammas à plusieurs spots sur la même résolution
+    PriceProfile price_profile(const std::vector<double>& spots) const;
+
+    // Frontière d'exercice S*(tau), un point par pas de temps de la grille
+    ExerciseBoundary exercise_boundary() const;
+
+    // Chaîne d'options vanille de même maturité (strikes, calls et puts) sur
+    // la grille uniforme de ce pricer, Greeks en S0. volatilities : une par
+    // option, ou vide (volatilité du pricer). Options résolues par blocs de
+    // kChainLanes, valeurs entrelacées nœud × option : chaque pas du stencil
+    // et des substitutions est une boucle de longueur fixe sur le bloc,
+    // laissée à l'auto-vectorisation du compilateur.
+    // Contrainte par projection, sans dividendes
+    std::vector<GridGreeks> price_chain(const std::vector<Option>& options,
+                                        const std::vector<double>& volatilities = {}) const;
+
+    // Dividendes discrets : saut V(S, t-) = V(S - D, t+) à chaque date ex,
+    // nœud exact de la grille en temps (inséré entre deux pas). Le spot
+    // entier est lognormal entre deux dates ex : modèle différent du spot
+    // « escrowed » de BinomialTreePricer::set_dividends, dont les prix
+    // sont plus bas pour un put (voir ce dernier)
+    void set_dividends(const DividendSchedule& dividends);
+    const DividendSchedule& dividends() const { return dividends_; }
+
+    // Grille log-spot : concentration = largeur de la zone dense (en log S)
+    // rapportée à sigma sqrt(T). Plus petite, plus de nœuds près de K et S0
+    void set_grid(Grid grid, double concentration = kDefaultConcentration);
+    Grid grid() const { return grid_; }
+    double concentration() const { return concentration_; }
+
+    // Résolution de l'LCP A V >= d, V >= payoff, complémentarité, à chaque pas
+    void set_constraint(Constraint constraint);
+    Constraint constraint() const { return constraint_; }
+
+    // Démarrage de Rannacher (Crank-Nicolson) : les premiers pas après la
+    // maturité, chaque date ex et chaque date de surveillance sont remplacés
+    // par deux demi-pas implicites, qui amortissent les oscillations issues
+    // des discontinuités. Désactivé par défaut (0) ; 2 pas pour des gammas et
+    // profils lisses
+    void set_rannacher_steps(std::size_t steps);
+    std::size_t rannacher_steps() const { return rannacher_steps_; }
+
+    // Exercice américain par défaut ; européen pour les barrières knock-in
+    void set_exercise(Exercise exercise);
+    Exercise exercise() const { return exercise_; }
+
+    // Payoffs Barrier* : surveillance continue par défaut, domaine tronqué à
+    // la barrière (nœud de bord, Dirichlet V = rebate). Dates de surveillance
+    // non vides : grille complète, barrière placée sur un nœud, knock-out
+    // appliqué aux seuls pas de ces dates. Knock-in (européen) par parité
+    // in/out : vanille - knock-out, deux résolutions
+    void set_monitoring_dates(std::vector<double> dates);
+    const std::vector<double>& monitoring_dates() const { return monitoring_dates_; }
+
+    // Rebate d'un knock-out, versé à la sortie
+    void set_rebate(double rebate);
+    double rebate() const { return rebate_; }
+
+    // Erreur contrôlée (tolerance > 0) : (M, N) du constructeur comme grille
+    // de départ, doublés en espace et en temps jusqu'à ce que l'erreur
+    // estimée du prix (Richardson entre les deux dernières grilles) passe
+    // sous la tolérance, au plus kMaxRefinements fois. Pas de temps fins près
+    // de la maturité, croissants ensuite. Prix et Greeks extrapolés.
+    // 0 : grille fixe (défaut)
+    void set_tolerance(double tolerance);
+    double tolerance() const { return tolerance_; }
+
+    // Erreur estimée du prix de la grille la plus fine (mode à erreur
+    // contrôlée ; peut dépasser la tolérance si le raffinement a plafonné)
+    double error_estimate() const;
+
+    // Grille de la résolution : (M, N), ou la plus fine en erreur contrôlée
+    std::size_t space_points() const;
+    std::size_t time_steps() const;
 
 private:
-    // Schéma Crank-Nicolson pour une meilleure stabilité
-    double price_explicit() const;
-    double price_implicit() const;
-    double price_crank_nicolson() const;
-    
-    // Résolution système tridiagonal (pour schémas implicites)
+    // Tampons d'une résolution, réutilisés d'un appel à l'autre (un par thread) :
+    // aucune allocation dans la boucle en temps une fois la capacité atteinte
+    struct Workspace
+    {
+        std::vector<double> nodes, times, obstacle, dividend;              // Grilles, valeur d'exercice, dividendes par pas
+        std::vector<double> grid, next, later;                             // Tranches n + 1, n et t = dt
+        std::vector<double> lower, diag, upper;                            // Opérateur L
+        std::vector<double> a, b, c, d;                                    // Système (I - theta dt L) et second membre
+        std::vector<double> explicit_lower, explicit_diag, explicit_upper; // I + (1 - theta) dt L
+        std::vector<double> ratio, inverse_pivot;                          // Factorisation de (a, b, c)
+        bool from_top = false;                                             // Sens de l'élimination
+        double relaxation = 1.0;                                           // Omega du PSOR
+        std::vector<double> policy_system[4], scratch, spline[6];
+        std::vector<char> exercised, previous, monitored;
+    };
+
+    // Résolution en cache : tranche t = 0 (spline) et valeur en S0 au
+    // premier pas de temps t = later_time
+    struct Solution
+    {
+        std::vector<double> nodes, values, curvature;
+        double later_value = 0.0;
+        double later_time = 0.0;
+    };
+
+    static Workspace& workspace();
+
+    // Poids implicite du schéma (0 explicite, 1 implicite, 1/2 Crank-Nicolson)
+    double implicit_weight() const;
+
+    // Remontée theta-schéma factorisée une fois, résultat dans solution ;
+    // knock_out : condition de barrière active ; boundary : si non nul,
+    // reçoit S* à chaque pas (tau croissant)
+    void solve(Solution& solution, bool knock_out, std::vector<double>* boundary = nullptr) const;
+
+    // Résout si nécessaire (knock-out, et vanille pour un knock-in)
+    void ensure_solved() const;
+
+    // Erreur contrôlée : grilles raffinées jusqu'à la tolérance (fine_level_,
+    // coarse_level_, order_, error_estimate_)
+    void refine() const;
+
+    // Extrapolation de Richardson à l'ordre observé
+    double extrapolate(double fine, double coarse) const;
+
+    // Valeur, delta et gamma au spot sur les résolutions en cache (parité
+    // in/out, barrière déjà franchie en surveillance continue)
+    void read(double spot, double& value, double& delta, double& gamma) const;
+
+    // Nœuds S_0 < ... < S_M de la grille ; knock_out et surveillance
+    // continue : domaine tronqué à la barrière
+    void spot_grid(std::vector<double>& nodes, bool knock_out) const;
+    void log_spot_grid(std::vector<double>& nodes, bool truncate) const;
+
+    // Condition de Dirichlet au nœud de bord S, temps restant tau
+    double edge_value(double S, double tau, bool at_barrier) const;
+    double edge_value(const Payoff& payoff, double S, double tau) const;
+
+    // Remontée d'un bloc de la chaîne, options [first, first + kChainLanes)
+    // (dernier bloc complété par la dernière option)
+    void solve_chain(const std::vector<const Payoff*>& payoffs, const std::vector<double>& volatilities,
+                     std::size_t first, GridGreeks* greeks) const;
+
+    // Dates t_0 = 0 < ... < T de la grille en temps (N pas, plus un nœud par
+    // date ex ou de surveillance hors grille), et pas le plus proche d'une date
+    void time_grid(std::vector<double>& times) const;
+    std::size_t nearest_step(const std::vector<double>& times, double t) const;
+
+    // Nœuds des dates de surveillance, et knock-out sur une tranche
+    void monitoring_steps(const std::vector<double>& times, std::vector<char>& monitored) const;
+    void apply_knock_out(std::vector<double>& values, const std::vector<double>& nodes) const;
+
+    bool knock_in() const;
+
+    // Opérateur L V = 0.5 sigma² S² V_SS + b S V_S - r V aux nœuds intérieurs :
+    // (L V)_i = lower_i V_(i-1) + diag_i V_i + upper_i V_(i+1). Différences à
+    // trois points sur pas non uniformes, en S ou en log S selon la grille
+    void build_operator(const std::vector<double>& nodes,
+                        std::vector<double>& lower,
+                        std::vector<double>& diag,
+                        std::vector<double>& upper) const;
+
+    // Dérivées secondes de la spline cubique naturelle d'une tranche, dans la
+    // coordonnée de la grille (S ou log S)
+    void fit_spline(const std::vector<double>& nodes, const std::vector<double>& values,
+                    std::vector<double>& curvature) const;
+
+    // Valeur, dV/dS et d²V/dS² de la spline au spot
+    void evaluate_spline(const std::vector<double>& nodes, const std::vector<double>& values,
+                         const std::vector<double>& curvature, double spot,
+                         double& value, double& delta, double& gamma) const;
+
+    // S* sur une tranche de la grille après la contrainte américaine
+    void record_boundary(const std::vector<double>& values, const std::vector<double>& nodes,
+                         std::vector<double>& boundary) const;
+
+    // Montant versé à chaque pas de temps (dates ex sur la grille)
+    void dividend_steps(const std::vector<double>& times, std::vector<double>& amounts) const;
+
+    // Condition de saut en place (interpolation linéaire), puis contrainte américaine
+    void apply_dividend(std::vector<double>& values, const std::vector<double>& nodes,
+                        const std::vector<double>& obstacle, double amount) const;
+
+    // Factorisation de (a, b, c) et relaxation PSOR, une fois par résolution
+    void factorize(Workspace& w) const;
+
+    // Substitutions sur la factorisation, second membre d ; obstacle non nul :
+    // contrainte appliquée pendant la substitution (Brennan-Schwartz)
+    void substitute(const Workspace& w, const double* obstacle, double* x) const;
+
+    // LCP tridiagonal sous l'obstacle selon constraint_ : w.next à partir de w.d
+    void solve_constrained(Workspace& w) const;
+    void solve_psor(Workspace& w) const;
+    void solve_policy_iteration(Workspace& w) const;
+
+    // Résolution système tridiagonal (Thomas), c_prime : tampon de travail
     void solve_tridiagonal(const std::vector<double>& a,
                           const std::vector<double>& b,
                           const std::vector<double>& c,
                           const std::vector<double>& d,
-                          std::vector<double>& x) const;
+                          std::vector<double>& x,
+                          std::vector<double>& c_prime) const;
+
+    // Demi-largeur du domaine log-spot, en sigma sqrt(T), autour de S0 et K
+    static constexpr double kDomainWidth = 6.0;
+    static constexpr double kDefaultConcentration = 0.5;
+
+    // PSOR : borne du facteur de relaxation, tolérance (mise à jour max) et itérations
+    static constexpr double kPsorMaxRelaxation = 1.95;
+
+    static constexpr std::size_t kDefaultRannacherSteps = 0;
+    static constexpr double kPsorTolerance = 1e-10;
+    static constexpr std::size_t kPsorMaxIterations = 10000;
+
+    // Borne haute minimale (uniforme) en multiples de la barrière : barrière intérieure
+    static constexpr double kBarrierMargin = 2.0;
+
+    // Options par bloc de price_chain : blocs de 8 options pour
+    // l'auto-vectorisation (largeur des registres selon la cible de compilation)
+    static constexpr std::size_t kChainLanes = 8;
+
+    // Erreur contrôlée : poids w du terme quadratique de la grille en temps,
+    // nombre maximal de doublements de la grille de départ
+    static constexpr double kTimeGrading = 0.5;
+    static constexpr std::size_t kMaxRefinements = 5;
 
     const Option& option_;
     double S0_, r_, b_, sigma_;
     std::size_t M_, N_;
     double Smax_;
     Scheme scheme_; // Pour specifier le schéma numérique
-};
\ No newline at end of file
+    DividendSchedule dividends_;
+    Grid grid_ = Grid::Uniform;
+    double concentration_ = kDefaultConcentration;
+    Constraint constraint_ = Constraint::Projection;
+    std::size_t rannacher_steps_ = kDefaultRannacherSteps;
+    Exercise exercise_ = Exercise::American;
+
+    // Barrière (nul : payoff vanille)
+    const BarrierPayoff* barrier_ = nullptr;
+    std::vector<double> monitoring_dates_;
+    double rebate_ = 0.0;
+
+    // Erreur contrôlée ; graded_ : grille en temps non uniforme (niveaux)
+    double tolerance_ = 0.0;
+    bool graded_ = false;
+
+    // Dernières résolutions : knock-out (ou vanille sans barrière), vanille des knock-in
+    mutable bool solved_ = false;
+    mutable Solution solution_, vanilla_;
+
+    // Erreur contrôlée : deux dernières grilles, ordre observé, erreur estimée
+    mutable std::shared_ptr<const FiniteDifferenceAmericanPricer> fine_level_, coarse_level_;
+    mutable double order_ = 2.0;
+    mutable double error_estimate_ = 0.0;
+};
@@ -5,11 +5,18 @@
 #include "monte_carlo_pricer.hpp"
 #include "finite_difference_pricer.hpp"
 #include "binomial_tree_pricer.hpp"
+#include "trinomial_barrier_pricer.hpp"
+#include "path_dependent_tree_pricer.hpp"
+#include "two_asset_tree_pricer.hpp"
+#include "adi_pricer.hpp"
+#include "dupire_pricer.hpp"
+#include "dividend_schedule.hpp"
 #include "replication_strategy.hpp"
 
 #include <iostream>
 #include <iomanip>
 #include <memory>
+#include <cmath>
 
 /* =========================================================
    FONCTIONS UTILITAIRES POUR L'AFFICHAGE
@@ -64,12 +71,44 @@ void print_greeks(const std::string& label, const Pricer& pricer, double spot)
     }
 }
 
+// Contrôle : affiche le résultat et compte les échecs (code de sortie de main)
+void check(const std::string& label, bool ok, int& failures)
+{
+    std::cout << (ok ? "  [OK]     " : "  [ÉCHEC]  ") << label << std::endl;
+    if (!ok)
+        ++failures;
+}
+
+// Up-and-out call à surveillance continue, K < B (formule fermée de
+// Reiner-Rubinstein) : vanille moins up-and-in
+double up_and_out_call(double S, double K, double B, double r, double b, double sigma, double T)
+{
+    auto N = [](double x) { return 0.5 * std::erfc(-x / std::sqrt(2.0)); };
+    double sT = sigma * std::sqrt(T);
+    double lambda = (b + 0.5 * sigma * sigma) / (sigma * sigma);
+    double carry = S * std::exp((b - r) * T);
+    double discount = K * std::exp(-r * T);
+
+    double d1 = std::log(S / K) / sT + lambda * sT;
+    double x1 = std::log(S / B) / sT + lambda * sT;
+    double y = std::log(B * B / (S * K)) / sT + lambda * sT;
+    double y1 = std::log(B / S) / sT + lambda * sT;
+
+    double call = carry * N(d1) - discount * N(d1 - sT);
+    double up_in = carry * N(x1) - discount * N(x1 - sT)
+                 - carry * std::pow(B / S, 2.0 * lambda) * (N(-y) - N(-y1))
+                 + discount * std::pow(B / S, 2.0 * lambda - 2.0) * (N(-y + sT) - N(-y1 + sT));
+    return call - up_in;
+}
+
 /* =========================================================
    MAIN POUR LE TEST
    ========================================================= */
 
 int main()
 {
+    int failures = 0;
+
     // Paramètres de marché
     double S0 = 100.0;     // Spot
     double K = 100.0;      // Strike
@@ -111,6 +150,14 @@ int main()
     std::cout << "  IC 95% : [" << mcResult.ci_lower_95 << ", " 
               << mcResult.ci_upper_95 << "]" << std::endl;
 
+    // Run réparti sur 4 processus : mêmes sous-flux, même prix au bit près
+    MCResult mcSharded = mc.price_sharded(4);
+    print_price_result("Monte Carlo (4 workers)", mcSharded.price);
+    check("Prix réparti identique au prix séquentiel",
+          mcSharded.price == mcResult.price && mcSharded.std_error == mcResult.std_error
+              && mc.price() == mcResult.price,
+          failures);
+
     // Arbre binomial CRR
     BinomialTreePricer tree_crr(europeanCall, S0, r, b, sigma, tree_steps, false,
                                 BinomialTreePricer::TreeType::CoxRossRubinstein);
@@ -139,12 +186,81 @@ int main()
     );
     print_price_result("Différences Finies (Crank-Nicolson)", fd_cn.price());
 
+    // Greeks lus sur la solution : démarrage de Rannacher contre les
+    // oscillations du gamma au strike
+    fd_cn.set_rannacher_steps(2);
+    print_price_result("Différences Finies (Rannacher)", fd_cn.price());
+    print_greeks("Différences Finies (une résolution)", fd_cn, S0);
+
+    // Grille log-spot concentrée sur le strike : même précision avec moins de points
+    FiniteDifferenceAmericanPricer fd_log(americanPut, S0, r, b, sigma, fd_M / 2, fd_N);
+    fd_log.set_grid(FiniteDifferenceAmericanPricer::Grid::LogSpot);
+    print_price_result("Différences Finies (log-spot, M / 2)", fd_log.price());
+
+    // Contrainte américaine résolue comme un LCP (Brennan-Schwartz) plutôt que projetée
+    fd_log.set_constraint(FiniteDifferenceAmericanPricer::Constraint::BrennanSchwartz);
+    print_price_result("Différences Finies (Brennan-Schwartz)", fd_log.price());
+
+    // Erreur contrôlée : grilles doublées jusqu'à la tolérance, prix extrapolé
+    FiniteDifferenceAmericanPricer fd_tol(americanPut, S0, r, b, sigma, 50, 25);
+    fd_tol.set_tolerance(1e-3);
+    print_price_result("Différences Finies (tolérance 1e-3)", fd_tol.price());
+    std::cout << "  Erreur estimée : " << fd_tol.error_estimate()
+              << " (M = " << fd_tol.space_points() << ", N = " << fd_tol.time_steps() << ")" << std::endl;
+
     // Comparaison européenne vs américaine
     BinomialTreePricer tree_eu_put(americanPut, S0, r, b, sigma, tree_steps, false);
     print_price_result("Même Put Européen (référence)", tree_eu_put.price());
     std::cout << "Prime d'exercice anticipé : " 
               << (tree_am.price() - tree_eu_put.price()) << std::endl;
 
+    // Chaîne de puts américains sur le même treillis (une seule remontée)
+    std::vector<Option> putChain;
+    for (double strike : {90.0, 95.0, 100.0, 105.0, 110.0})
+        putChain.emplace_back(T, std::make_shared<Payoff>(strike, OptionType::Put));
+
+    std::vector<TreeGreeks> chainGreeks = tree_am.price_chain(putChain);
+    std::cout << "\nChaîne de puts américains (strike : prix / delta) :" << std::endl;
+    for (std::size_t k = 0; k < putChain.size(); ++k)
+        std::cout << "  K = " << putChain[k].payoff().strike() << " : "
+                  << chainGreeks[k].price << " / " << chainGreeks[k].delta << std::endl;
+
+    // Même chaîne en différences finies : options résolues ensemble, valeurs
+    // entrelacées (une opération vectorielle par nœud pour tout le bloc)
+    std::vector<GridGreeks> fdChain = fd_cn.price_chain(putChain);
+    std::cout << "Même chaîne en différences finies (strike : prix / delta) :" << std::endl;
+    for (std::size_t k = 0; k < putChain.size(); ++k)
+        std::cout << "  K = " << putChain[k].payoff().strike() << " : "
+                  << fdChain[k].price << " / " << fdChain[k].delta << std::endl;
+
+    // Frontière d'exercice extraite de l'arbre : reprix à d'autres spots
+    // par l'intégrale de prime, sans nouvelle remontée
+    ExerciseBoundary boundary = tree_am.exercise_boundary();
+    std::cout << "\nFrontière d'exercice S*(T) = " << boundary.critical_spot(T) << std::endl;
+    for (double spot : {90.0, 100.0, 110.0})
+        std::cout << "  S = " << spot << " : " << boundary.price(spot) << std::endl;
+
+    // Même reprix après résolution de l'équation intégrale de la frontière
+    ExerciseBoundary refined = boundary;
+    refined.refine();
+    std::cout << "Frontière raffinée (équation intégrale) :" << std::endl;
+    for (double spot : {90.0, 100.0, 110.0})
+        std::cout << "  S = " << spot << " : " << refined.price(spot) << std::endl;
+
+    // Dividendes discrets : deux versements de 2 dans l'année. Les deux
+    // moteurs n'ont pas le même modèle : l'arbre diffuse le spot net des
+    // dividendes à venir (« escrowed »), les différences finies le spot
+    // entier, qui saute à chaque date ex. Volatilité effective plus forte
+    // dans le second cas, d'où un put plus cher (écart de modèle, pas d'erreur)
+    DividendSchedule dividends({{0.3, 2.0}, {0.8, 2.0}});
+    BinomialTreePricer tree_div(americanPut, S0, r, b, sigma, tree_steps, true);
+    tree_div.set_dividends(dividends);
+    FiniteDifferenceAmericanPricer fd_div(americanPut, S0, r, b, sigma, fd_M, fd_N);
+    fd_div.set_dividends(dividends);
+    std::cout << "\nPut américain avec dividendes discrets :" << std::endl;
+    print_price_result("Arbre (spot escompté)", tree_div.price());
+    print_price_result("Différences Finies (saut aux dates ex)", fd_div.price());
+
     /* =================================================================
        PARTIE 3 : OPTIONS EXOTIQUES - ASIATIQUES
        ================================================================= */
@@ -168,6 +284,14 @@ int main()
     MonteCarloPricer mcAsianGeo(asianGeoOpt, S0, r, b, sigma, mc_paths, mc_steps, 42, true);
     print_price_result("Asian Call (Moyenne géométrique)", mcAsianGeo.price());
 
+    // Arbre Hull-White (mêmes dates de moyenne que le MC) : déterministe,
+    // et exercice américain sur la moyenne courante
+    PathDependentTreePricer treeAsian(asianOpt, S0, r, b, sigma, mc_steps);
+    PathDependentTreePricer treeAsianAm(asianOpt, S0, r, b, sigma, mc_steps, true);
+    print_price_result("Asian Call (arbre Hull-White)", treeAsian.price());
+    print_price_result("Asian Call US (arbre Hull-White)", treeAsianAm.price());
+    std::cout << "Delta (arbre) : " << treeAsian.delta(S0) << std::endl;
+
     /* =================================================================
        PARTIE 4 : OPTIONS LOOKBACK
        ================================================================= */
@@ -191,6 +315,10 @@ int main()
     MonteCarloPricer mcLookbackFloat(lookbackFloatOpt, S0, r, b, sigma, mc_paths, mc_steps, 42, true);
     print_price_result("Lookback Call (Strike flottant)", mcLookbackFloat.price());
 
+    // Arbre : extrêmes exacts sur la grille, pas de bruit Monte Carlo
+    PathDependentTreePricer treeLookback(lookbackOpt, S0, r, b, sigma, mc_steps);
+    print_price_result("Lookback Call (arbre)", treeLookback.price());
+
     /* =================================================================
        PARTIE 5 : OPTIONS BARRIÈRES
        ================================================================= */
@@ -221,6 +349,49 @@ int main()
               << (mcBarrierUpOut.price() + mcBarrierUpIn.price())
               << " (Vanille = " << mc.price() << ")" << std::endl;
 
+    // Treillis trinomial (barrière sur un nœud, surveillance continue :
+    // légèrement sous le MC, surveillé à chaque pas de temps seulement)
+    TrinomialBarrierPricer triUpOut(barrierUpOutOpt, S0, r, b, sigma, 200);
+    TrinomialBarrierPricer triUpIn(barrierUpInOpt, S0, r, b, sigma, 200);
+    print_price_result("Up-and-Out Call (trinomial)", triUpOut.price());
+    print_price_result("Up-and-In Call (trinomial)", triUpIn.price());
+
+    // Chaque niveau de maillage adaptatif doit rapprocher de la formule fermée
+    double upOutExact = up_and_out_call(S0, K, barrier_up, r, b, sigma, T);
+    print_price_result("Up-and-Out Call (formule fermée)", upOutExact);
+    double previousError = 0.0;
+    bool converging = true;
+    for (std::size_t levels = 0; levels <= 4; ++levels)
+    {
+        TrinomialBarrierPricer triLevel(barrierUpOutOpt, S0, r, b, sigma, 200, false, levels);
+        double error = std::abs(triLevel.price() - upOutExact);
+        std::cout << std::left << std::setw(40) << ("  Écart, " + std::to_string(levels) + " niveau(x)")
+                  << ": " << std::scientific << std::setprecision(2) << error
+                  << std::fixed << std::setprecision(4) << std::endl;
+        converging = converging && (levels == 0 || error < previousError);
+        previousError = error;
+    }
+    check("Erreur décroissante avec les niveaux de raffinement", converging, failures);
+
+    // Version américaine : hors de portée du Monte Carlo
+    TrinomialBarrierPricer triUpOutAm(barrierUpOutOpt, S0, r, b, sigma, 200, true);
+    print_price_result("Up-and-Out Call US (trinomial)", triUpOutAm.price());
+
+    // EDP : domaine tronqué à la barrière, knock-in par parité (européen)
+    FiniteDifferenceAmericanPricer fdUpOut(barrierUpOutOpt, S0, r, b, sigma, fd_M, fd_N);
+    FiniteDifferenceAmericanPricer fdUpIn(barrierUpInOpt, S0, r, b, sigma, fd_M, fd_N);
+    fdUpOut.set_exercise(FiniteDifferenceAmericanPricer::Exercise::European);
+    fdUpIn.set_exercise(FiniteDifferenceAmericanPricer::Exercise::European);
+    print_price_result("Up-and-Out Call (EDP)", fdUpOut.price());
+    print_price_result("Up-and-In Call (EDP)", fdUpIn.price());
+
+    // Surveillance aux mc_steps dates des paths Monte Carlo
+    std::vector<double> monitoring;
+    for (std::size_t k = 1; k <= mc_steps; ++k)
+        monitoring.push_back(T * static_cast<double>(k) / static_cast<double>(mc_steps));
+    fdUpOut.set_monitoring_dates(monitoring);
+    print_price_result("Up-and-Out Call (EDP, dates du MC)", fdUpOut.price());
+
     /* =================================================================
        PARTIE 6 : OPTIONS DIGITALES
        ================================================================= */
@@ -336,5 +507,117 @@ int main()
                   << ", Erreur = " << std::setw(10) << error << std::endl;
     }
 
-    return 0;
+    std::cout << "\nLeisen-Reimer et BBSR (Call européen) :" << std::endl;
+    for (int steps : {25, 50, 100})
+    {
+        BinomialTreePricer tree_lr(europeanCall, S0, r, b, sigma, static_cast<long unsigned int>(steps), false,
+                                   BinomialTreePricer::TreeType::LeisenReimer);
+        BinomialTreePricer tree_bbsr(europeanCall, S0, r, b, sigma, static_cast<long unsigned int>(steps), false,
+                                     BinomialTreePricer::TreeType::CoxRossRubinstein,
+                                     BinomialTreePricer::Smoothing::BlackScholesRichardson);
+        std::cout << "  N = " << std::setw(4) << steps
+                  << " : Erreur LR = " << std::setw(10) << std::abs(tree_lr.price() - bs_reference)
+                  << ", Erreur BBSR = " << std::setw(10) << std::abs(tree_bbsr.price() - bs_reference)
+                  << std::endl;
+    }
+
+    /* =================================================================
+       PARTIE 12 : PORTEFEUILLE D'EXOTIQUES SUR PATHS PARTAGÉS
+       ================================================================= */
+    print_header("PARTIE 12 : PORTEFEUILLE SUR PATHS PARTAGÉS");
+
+    // Un seul jeu de paths pour tous les exotiques de même maturité
+    std::vector<Option> book = {
+        asianOpt, asianGeoOpt, lookbackOpt, lookbackFloatOpt,
+        barrierUpOutOpt, barrierUpInOpt, digitalCallOpt, powerCallOpt
+    };
+    std::vector<std::string> labels = {
+        "Asian Call (arithmétique)", "Asian Call (géométrique)",
+        "Lookback Call (fixe)", "Lookback Call (flottant)",
+        "Barrier Up-and-Out Call", "Barrier Up-and-In Call",
+        "Digital Call", "Power Call"
+    };
+
+    auto book_results = mc.price_portfolio(book);
+    for (std::size_t i = 0; i < book.size(); ++i)
+    {
+        std::cout << std::left << std::setw(30) << labels[i]
+                  << ": " << std::setw(10) << book_results[i].price
+                  << " IC 95% [" << book_results[i].ci_lower_95 << ", "
+                  << book_results[i].ci_upper_95 << "]" << std::endl;
+    }
+
+    /* =================================================================
+       PARTIE 13 : OPTIONS SUR DEUX SOUS-JACENTS
+       ================================================================= */
+    print_header("PARTIE 13 : OPTIONS SUR DEUX SOUS-JACENTS");
+
+    // Second sous-jacent corrélé, dividende 3% sur le premier
+    double S2 = 95.0, b1 = r - 0.03, sigma2 = 0.30, rho = 0.5;
+
+    TwoAssetPayoff exchange(TwoAssetPayoff::Style::Exchange, OptionType::Call);
+    TwoAssetTreePricer exchangeEu(exchange, T, S0, S2, r, b1, r, sigma, sigma2, rho, tree_steps);
+    TwoAssetTreePricer exchangeAm(exchange, T, S0, S2, r, b1, r, sigma, sigma2, rho, tree_steps,
+                                  TwoAssetTreePricer::Exercise::American);
+    print_price_result("Échange S1 -> S2 (européen)", exchangeEu.price());
+    print_price_result("Échange S1 -> S2 (américain)", exchangeAm.price());
+
+    TwoAssetPayoff bestOf(TwoAssetPayoff::Style::BestOf, OptionType::Call, K);
+    TwoAssetTreePricer bestOfBerm(bestOf, T, S0, S2, r, b1, r, sigma, sigma2, rho, tree_steps,
+                                  TwoAssetTreePricer::Exercise::Bermudan, 4);
+    print_price_result("Best-of Call (bermudéen, 4 dates)", bestOfBerm.price());
+
+    // EDP bidimensionnelle (ADI Hundsdorfer-Verwer) : prix et deltas lisses
+    TwoAssetAdiPricer exchangeAdi(exchange, T, S0, S2, r, b1, r, sigma, sigma2, rho);
+    print_price_result("Échange S1 -> S2 (EDP ADI)", exchangeAdi.price());
+    std::cout << "  Delta S1 : " << exchangeAdi.delta(S0)
+              << "  Delta S2 : " << exchangeAdi.delta2() << std::endl;
+
+    /* =================================================================
+       PARTIE 14 : MODÈLE DE HESTON (EDP ADI)
+       ================================================================= */
+    print_header("PARTIE 14 : MODÈLE DE HESTON (EDP ADI)");
+
+    // Variance initiale et long terme 0.04 (vol 20%), skew négatif
+    double v0 = 0.04, kappa = 1.5, long_variance = 0.04, xi = 0.3, rho_v = -0.7;
+
+    HestonAdiPricer hestonCall(europeanCall, S0, r, b, v0, kappa, long_variance, xi, rho_v);
+    print_price_result("Heston Call européen (200 x 100)", hestonCall.price());
+    print_greeks("Heston ADI", hestonCall, S0);
+
+    HestonAdiPricer hestonPut(americanPut, S0, r, b, v0, kappa, long_variance, xi, rho_v,
+                              200, 100, 50, true);
+    print_price_result("Heston Put américain (200 x 100)", hestonPut.price());
+
+    /* =================================================================
+       PARTIE 15 : SURFACE DE PRIX PAR L'EDP DE DUPIRE
+       ================================================================= */
+    print_header("PARTIE 15 : SURFACE DE PRIX (EDP FORWARD DE DUPIRE)");
+
+    // Volatilité locale avec skew : plus élevée sous le spot
+    std::vector<double> lvStrikes = {60.0, 80.0, 100.0, 120.0, 140.0};
+    std::vector<std::vector<double>> lvValues = {{0.35, 0.28, 0.22, 0.19, 0.18},
+                                                 {0.32, 0.26, 0.21, 0.18, 0.17}};
+    LocalVolatilitySurface localVol(lvStrikes, {0.0, 1.0}, lvValues);
+    DupirePricer dupire(S0, r, b, localVol);
+
+    // Toute la surface en une résolution (au lieu d'une EDP rétrograde par option)
+    std::vector<double> surfaceStrikes = {80.0, 90.0, 100.0, 110.0, 120.0};
+    std::vector<double> surfaceMaturities = {0.25, 0.5, 1.0};
+    PriceSurface surface = dupire.price_surface(surfaceStrikes, surfaceMaturities);
+    std::cout << "Calls (vol locale), maturités en lignes :" << std::endl;
+    for (std::size_t j = 0; j < surfaceMaturities.size(); ++j)
+    {
+        std::cout << "  T = " << surfaceMaturities[j] << " :";
+        for (double price : surface.prices[j])
+            std::cout << " " << price;
+        std::cout << std::endl;
+    }
+
+    // Volatilité constante : même prix que Black-Scholes
+    DupirePricer dupireFlat(S0, r, b, LocalVolatilitySurface(sigma));
+    print_price_result("Dupire (vol constante)", dupireFlat.price_surface({K}, {T}).prices[0][0]);
+    print_price_result("Black-Scholes (référence)", bs.price());
+
+    return failures == 0 ? 0 : 1;
 }
\ No newline at end of file
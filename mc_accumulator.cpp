@@ -0,0 +1,192 @@
+#include "mc_accumulator.hpp"
+#include <cmath>
+#include <cstdlib>
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+/* =========================================================
+   ACCUMULATEUR MONTE CARLO - IMPLÉMENTATION
+   ========================================================= */
+
+MCAccumulator::MCAccumulator(unsigned seed,
+                             std::size_t planned_batches,
+                             std::size_t payoff_count,
+                             double discount)
+    : seed_(seed),
+      planned_batches_(planned_batches),
+      payoffs_(payoff_count),
+      discount_(discount)
+{
+    if (payoff_count == 0)
+        throw std::invalid_argument("Accumulator needs at least one payoff");
+}
+
+void MCAccumulator::add_batch(BatchRecord record)
+{
+    if (record.index >= planned_batches_)
+        throw std::invalid_argument("Batch index out of range");
+    if (record.sum.size() != payoffs_ || record.sum_plain_sq.size() != payoffs_)
+        throw std::invalid_argument("Batch record does not match payoff count");
+    if (batches_.count(record.index))
+        throw std::invalid_argument("Batch already accumulated");
+
+    std::size_t index = record.index;
+    batches_.emplace(index, std::move(record));
+}
+
+void MCAccumulator::merge(const MCAccumulator& other)
+{
+    // Les deux parties doivent provenir du même run
+    if (other.seed_ != seed_ || other.planned_batches_ != planned_batches_
+        || other.payoffs_ != payoffs_ || other.discount_ != discount_)
+        throw std::invalid_argument("Cannot merge accumulators from different runs");
+
+    for (const auto& entry : other.batches_)
+        add_batch(entry.second);
+}
+
+std::size_t MCAccumulator::count() const
+{
+    std::size_t total = 0;
+    for (const auto& entry : batches_)
+        total += entry.second.count;
+    return total;
+}
+
+std::vector<MCResult> MCAccumulator::results() const
+{
+    if (batches_.empty())
+        throw std::runtime_error("Accumulator is empty");
+
+    double n = static_cast<double>(count());
+    double nb = static_cast<double>(batches_.size());
+
+    std::vector<MCResult> out(payoffs_);
+    for (std::size_t p = 0; p < payoffs_; ++p)
+    {
+        // Réduction dans l'ordre des lots : résultat indépendant du découpage
+        double sum = 0.0, sum_plain_sq = 0.0;
+        double sum_batch = 0.0, sum_batch_sq = 0.0;
+        for (const auto& entry : batches_)
+        {
+            const BatchRecord& batch = entry.second;
+            double batch_mean = batch.sum[p] / static_cast<double>(batch.count);
+            sum += batch.sum[p];
+            sum_plain_sq += batch.sum_plain_sq[p];
+            sum_batch += batch_mean;
+            sum_batch_sq += batch_mean * batch_mean;
+        }
+
+        double mean = sum / n;
+        double mean_batch = sum_batch / nb;
+        double var_batch = (nb > 1.0)
+            ? std::max(sum_batch_sq - nb * mean_batch * mean_batch, 0.0) / (nb - 1.0)
+            : 0.0;
+
+        // MC naïf de même taille : Var_P(f) = E_Q[f² L] - prix²
+        double var_plain = std::max(sum_plain_sq / n - mean * mean, 0.0);
+
+        MCResult& result = out[p];
+        result.price = discount_ * mean;
+        result.std_error = discount_ * std::sqrt(var_batch / nb);
+        result.ci_lower_95 = result.price - 1.96 * result.std_error;
+        result.ci_upper_95 = result.price + 1.96 * result.std_error;
+        result.paths = count();
+        result.naive_std_error = discount_ * std::sqrt(var_plain / n);
+        result.variance_reduction = (result.std_error > 0.0)
+            ? (result.naive_std_error * result.naive_std_error) / (result.std_error * result.std_error)
+            : 1.0;
+    }
+
+    return out;
+}
+
+/* =========================================================
+   SÉRIALISATION
+   ========================================================= */
+
+std::string MCAccumulator::to_string() const
+{
+    // Format texte ligne par ligne, flottants en hexadécimal (aller-retour exact)
+    std::ostringstream out;
+    out << std::hexfloat;
+    out << "MCACC 1\n";
+    out << seed_ << " " << planned_batches_ << " " << payoffs_ << " "
+        << discount_ << " " << batches_.size() << "\n";
+
+    for (const auto& entry : batches_)
+    {
+        const BatchRecord& batch = entry.second;
+        out << batch.index << " " << batch.count;
+        for (std::size_t p = 0; p < payoffs_; ++p)
+            out << " " << batch.sum[p] << " " << batch.sum_plain_sq[p];
+        out << "\n";
+    }
+
+    return out.str();
+}
+
+MCAccumulator MCAccumulator::from_string(const std::string& text)
+{
+    std::istringstream in(text);
+    std::string token;
+
+    // operator>> ne relit pas les flottants hexadécimaux : on passe par strtod
+    auto next = [&]() -> std::string
+    {
+        if (!(in >> token))
+            throw std::runtime_error("Truncated accumulator data");
+        return token;
+    };
+    auto next_double = [&]() { return std::strtod(next().c_str(), nullptr); };
+    auto next_size = [&]() { return static_cast<std::size_t>(std::stoull(next())); };
+
+    if (next() != "MCACC" || next() != "1")
+        throw std::runtime_error("Invalid accumulator header");
+
+    unsigned seed = static_cast<unsigned>(next_size());
+    std::size_t planned = next_size();
+    std::size_t payoffs = next_size();
+    double discount = next_double();
+    std::size_t stored = next_size();
+
+    MCAccumulator acc(seed, planned, payoffs, discount);
+    for (std::size_t k = 0; k < stored; ++k)
+    {
+        BatchRecord batch;
+        batch.index = next_size();
+        batch.count = next_size();
+        batch.sum.resize(payoffs);
+        batch.sum_plain_sq.resize(payoffs);
+        for (std::size_t p = 0; p < payoffs; ++p)
+        {
+            batch.sum[p] = next_double();
+            batch.sum_plain_sq[p] = next_double();
+        }
+        acc.add_batch(std::move(batch));
+    }
+
+    return acc;
+}
+
+void MCAccumulator::save(const std::string& filename) const
+{
+    std::ofstream file(filename);
+    if (!file.is_open())
+        throw std::runtime_error("Cannot open file: " + filename);
+
+    file << to_string();
+}
+
+MCAccumulator MCAccumulator::load(const std::string& filename)
+{
+    std::ifstream file(filename);
+    if (!file.is_open())
+        throw std::runtime_error("Cannot open file: " + filename);
+
+    std::ostringstream content;
+    content << file.rdbuf();
+    return from_string(content.str());
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <vector>
+#include <map>
+#include <string>
+#include <cstddef>
+
+/* =========================================================
+   STRUCTURE POUR RÉSULTATS MONTE CARLO
+   ========================================================= */
+struct MCResult
+{
+    double price;
+    double std_error;
+    double ci_lower_95;  // Intervalle de confiance à 95%
+    double ci_upper_95;
+
+    // Effet de la réduction de variance
+    std::size_t paths;          // Nombre de paths effectivement simulés
+    double naive_std_error;     // Erreur standard d'un MC naïf de même taille
+    double variance_reduction;  // (naive_std_error / std_error)²
+};
+
+/* =========================================================
+   ACCUMULATEUR MONTE CARLO (FUSIONNABLE ET SÉRIALISABLE)
+   ========================================================= */
+
+// Sommes partielles d'un run Monte Carlo, indexées par lot (sous-flux RNG).
+// Les lots sont conservés séparément et réduits dans l'ordre de leur indice :
+// fusionner des accumulateurs calculés sur des lots disjoints (threads,
+// processus, machines) donne exactement le même résultat qu'un run unique.
+class MCAccumulator
+{
+public:
+    // Sommes d'un lot, une entrée par payoff
+    struct BatchRecord
+    {
+        std::size_t index;                 // Indice du sous-flux RNG
+        std::size_t count;                 // Nombre de paths du lot
+        std::vector<double> sum;           // Σ f · L
+        std::vector<double> sum_plain_sq;  // Σ f² · L (second moment sous la mesure d'origine)
+    };
+
+    MCAccumulator() = default;
+    MCAccumulator(unsigned seed,
+                  std::size_t planned_batches,
+                  std::size_t payoff_count,
+                  double discount);
+
+    void add_batch(BatchRecord record);
+
+    // Fusion avec un accumulateur du même run portant sur d'autres lots
+    void merge(const MCAccumulator& other);
+
+    std::size_t payoff_count() const { return payoffs_; }
+    std::size_t batch_count() const { return batches_.size(); }
+    std::size_t planned_batches() const { return planned_batches_; }
+    std::size_t count() const;
+    bool is_complete() const { return batches_.size() == planned_batches_; }
+
+    // Prix, erreur standard (moyennes de lots) et IC par payoff
+    std::vector<MCResult> results() const;
+
+    // Sérialisation exacte (flottants en hexadécimal)
+    std::string to_string() const;
+    static MCAccumulator from_string(const std::string& text);
+
+    void save(const std::string& filename) const;
+    static MCAccumulator load(const std::string& filename);
+
+private:
+    unsigned seed_ = 0;
+    std::size_t planned_batches_ = 0;
+    std::size_t payoffs_ = 0;
+    double discount_ = 1.0;
+    std::map<std::size_t, BatchRecord> batches_;  // Trié par indice de lot
+};
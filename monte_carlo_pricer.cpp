@@ -1,7 +1,17 @@
 #include "monte_carlo_pricer.hpp"
+#include "path_store.hpp"
 #include <cmath>
 #include <numeric>
 #include <stdexcept>
+#include <limits>
+#include <fstream>
+#include <cstring>
+#include <algorithm>
+
+#ifndef _WIN32
+#include <unistd.h>
+#include <sys/wait.h>
+#endif
 
 /* =========================================================
    MONTE CARLO - IMPLÉMENTATION
@@ -24,7 +34,17 @@ MonteCarloPricer::MonteCarloPricer(const Option& option,
       paths_(paths),
       steps_(steps),
       seed_(seed),
-      use_antithetic_(use_antithetic)
+      use_antithetic_(use_antithetic),
+      is_enabled_(false),
+      is_auto_(false),
+      is_shift_(0.0),
+      is_pilot_paths_(0),
+      is_shift_cached_(false),
+      is_cached_shift_(0.0),
+      sampling_(SamplingScheme::Standard),
+      moment_matching_(false),
+      batch_count_(32),
+      precision_(Precision::Double)
 {
     // Controles pour validation
     if (spot <= 0.0)
@@ -39,109 +59,15 @@ MonteCarloPricer::MonteCarloPricer(const Option& option,
 
 double MonteCarloPricer::price() const
 {
-    double T = option_.maturity();
-    double dt = T / static_cast<double>(steps_);
-
-    std::mt19937 gen(seed_);
-    std::normal_distribution<> N(0.0, 1.0);
-
-    double sum = 0.0;
-
-    // Variables antithétiques pour réduction de variance
-    if (use_antithetic_)
-    {
-        std::size_t half_paths = paths_ / 2;
-        
-        for (std::size_t i = 0; i < half_paths; ++i)
-        {
-            // Path 1 avec Z
-            std::vector<double> path1(steps_ + 1);
-            path1[0] = S0_;
-
-            for (std::size_t j = 1; j <= steps_; ++j)
-            {
-                double Z = N(gen);
-                path1[j] = path1[j - 1] * std::exp(
-                    (b_ - 0.5 * sigma_ * sigma_) * dt
-                    + sigma_ * std::sqrt(dt) * Z
-                );
-            }
-
-            // Path 2 avec -Z (antithétique)
-            std::vector<double> path2(steps_ + 1);
-            path2[0] = S0_;
-
-            for (std::size_t j = 1; j <= steps_; ++j)
-            {
-                double Z = -N(gen);  // Utilise la même variable aléatoire négative
-                path2[j] = path2[j - 1] * std::exp(
-                    (b_ - 0.5 * sigma_ * sigma_) * dt
-                    + sigma_ * std::sqrt(dt) * Z
-                );
-            }
-
-            sum += option_.payoff()(path1);
-            sum += option_.payoff()(path2);
-        }
-        
-        // Si nombre impair de paths, ajouter un dernier
-        if (paths_ % 2 == 1)
-        {
-            auto path = simulate_path(gen);
-            sum += option_.payoff()(path);
-        }
-    }
-    else
-    {
-        // Sans variables antithétiques
-        for (std::size_t i = 0; i < paths_; ++i)
-        {
-            auto path = simulate_path(gen);
-            sum += option_.payoff()(path);
-        }
-    }
-
-    return std::exp(-r_ * T) * (sum / static_cast<double>(paths_));
+    // Toujours le moteur par lots : mêmes sous-flux que run_shard, le prix
+    // ne dépend donc pas du nombre de workers de price_sharded
+    return simulate_batches({&option_.payoff()}).front().price;
 }
 
 // Prix avec intervalle de confiance
 MCResult MonteCarloPricer::price_with_confidence() const
 {
-    double T = option_.maturity();
-    std::mt19937 gen(seed_);
-
-    std::vector<double> payoffs(paths_);
-
-    // Calculer tous les payoffs
-    for (std::size_t i = 0; i < paths_; ++i)
-    {
-        auto path = simulate_path(gen);
-        payoffs[i] = option_.payoff()(path);
-    }
-
-    // Calculer la moyenne
-    double mean = std::accumulate(payoffs.begin(), payoffs.end(), 0.0) / static_cast<double>(paths_);
-    
-    // Calculer la variance
-    double variance = 0.0;
-    for (double p : payoffs)
-        variance += (p - mean) * (p - mean);
-    variance /= static_cast<double>(paths_ - 1);
-    
-    // Prix actualisé
-    double price = std::exp(-r_ * T) * mean;
-    
-    // Erreur standard
-    double std_error = std::sqrt(variance / static_cast<double>(paths_)) * std::exp(-r_ * T);
-    
-    // Intervalle de confiance à 95% (1.96 * σ)
-    MCResult result;
-    result.price = price;
-    result.std_error = std_error;
-    result.ci_lower_95 = price - 1.96 * std_error;
-    result.ci_upper_95 = price + 1.96 * std_error;
-    
-    return result;
+    return simulate_batches({&option_.payoff()}).front();
 }
 
 double MonteCarloPricer::delta(double spot) const
@@ -149,8 +75,11 @@ double MonteCarloPricer::delta(double spot) const
     // Méthode par différences finies
     double h = 1e-4 * spot;
 
-    MonteCarloPricer up(option_, spot + h, r_, b_, sigma_, paths_, steps_, seed_, use_antithetic_);
-    MonteCarloPricer down(option_, spot - h, r_, b_, sigma_, paths_, steps_, seed_, use_antithetic_);
+    // Copies pour conserver la configuration (importance sampling, etc.)
+    MonteCarloPricer up(*this);
+    MonteCarloPricer down(*this);
+    up.S0_ = spot + h;
+    down.S0_ = spot - h;
 
     return (up.price() - down.price()) / (2.0 * h);
 }
@@ -196,38 +125,550 @@ double MonteCarloPricer::vega() const
 {
     double h = 1e-4;  // Perturbation de volatilité
 
-    MonteCarloPricer up(option_, S0_, r_, b_, sigma_ + h, paths_, steps_, seed_, use_antithetic_);
-    MonteCarloPricer down(option_, S0_, r_, b_, sigma_ - h, paths_, steps_, seed_, use_antithetic_);
+    MonteCarloPricer up(*this);
+    MonteCarloPricer down(*this);
+    up.sigma_ = sigma_ + h;
+    down.sigma_ = sigma_ - h;
 
     return (up.price() - down.price()) / (2.0 * h);
 }
 
 /* =========================================================
-   FONCTIONS PRIVÉES
+   IMPORTANCE SAMPLING (GIRSANOV)
    ========================================================= */
 
-std::vector<double> MonteCarloPricer::simulate_path(std::mt19937& gen) const
+void MonteCarloPricer::enable_importance_sampling(double drift_shift)
+{
+    is_enabled_ = true;
+    is_auto_ = false;
+    is_shift_ = drift_shift;
+    is_shift_cached_ = false;
+}
+
+void MonteCarloPricer::enable_importance_sampling_auto(std::size_t pilot_paths)
+{
+    if (pilot_paths < 100)
+        throw std::invalid_argument("Pilot pass needs at least 100 paths");
+
+    is_enabled_ = true;
+    is_auto_ = true;
+    is_pilot_paths_ = pilot_paths;
+    is_shift_cached_ = false;
+}
+
+void MonteCarloPricer::disable_importance_sampling()
+{
+    is_enabled_ = false;
+    is_auto_ = false;
+    is_shift_cached_ = false;
+}
+
+double MonteCarloPricer::importance_shift() const
+{
+    if (!is_enabled_)
+        return 0.0;
+    if (!is_auto_)
+        return is_shift_;
+
+    if (!is_shift_cached_)
+    {
+        is_cached_shift_ = find_optimal_shift();
+        is_shift_cached_ = true;
+    }
+    return is_cached_shift_;
+}
+
+/* =========================================================
+   MOTEUR PAR LOTS (STRATIFICATION, LHS, MOMENT MATCHING)
+   ========================================================= */
+
+void MonteCarloPricer::set_sampling_scheme(SamplingScheme scheme)
+{
+    sampling_ = scheme;
+}
+
+void MonteCarloPricer::set_moment_matching(bool enabled)
+{
+    moment_matching_ = enabled;
+}
+
+std::vector<MCResult> MonteCarloPricer::simulate_batches(
+    const std::vector<const Payoff*>& payoffs) const
+{
+    return accumulate(payoffs, 0, 1).results();
+}
+
+MCAccumulator MonteCarloPricer::accumulate(const std::vector<const Payoff*>& payoffs,
+                                           std::size_t shard,
+                                           std::size_t shard_count) const
+{
+    if (precision_ == Precision::Single)
+        return accumulate_impl<float>(payoffs, shard, shard_count);
+    return accumulate_impl<double>(payoffs, shard, shard_count);
+}
+
+template <typename Real>
+MCAccumulator MonteCarloPricer::accumulate_impl(const std::vector<const Payoff*>& payoffs,
+                                                std::size_t shard,
+                                                std::size_t shard_count) const
 {
     double T = option_.maturity();
-    double dt = T / static_cast<double>(steps_);
-    
+    double shift = importance_shift();
+    std::size_t count = payoffs.size();
+
+    // Les tirages d'un lot ne sont pas indépendants (strates, LHS, moments) :
+    // l'erreur standard est estimée par la dispersion des moyennes de lots
+    std::size_t batches = std::min<std::size_t>(paths_, batch_count_);
+
+    MCAccumulator acc(seed_, batches, count, std::exp(-r_ * T));
+    std::vector<Real> randoms;
+    std::vector<double> path(steps_ + 1);  // Les payoffs sont évalués en double
+
+    for (std::size_t k = shard; k < batches; k += shard_count)
+    {
+        std::size_t size = paths_ / batches + (k < paths_ % batches ? 1 : 0);
+
+        // Sous-flux indépendant par lot
+        std::seed_seq seq{seed_, static_cast<unsigned>(k)};
+        std::mt19937 gen(seq);
+
+        std::size_t rows = generate_batch(gen, size, randoms);
+
+        MCAccumulator::BatchRecord batch;
+        batch.index = k;
+        batch.count = rows;
+        batch.sum.assign(count, 0.0);
+        batch.sum_plain_sq.assign(count, 0.0);
+
+        for (std::size_t i = 0; i < rows; ++i)
+        {
+            // Un seul path simulé, évalué pour tous les payoffs
+            double likelihood = build_path(&randoms[i * steps_], shift, path);
+
+            for (std::size_t p = 0; p < count; ++p)
+            {
+                double f = (*payoffs[p])(path);
+                batch.sum[p] += f * likelihood;
+                batch.sum_plain_sq[p] += f * f * likelihood;
+            }
+        }
+
+        acc.add_batch(std::move(batch));
+    }
+
+    return acc;
+}
+
+/* =========================================================
+   PRÉCISION DU MOTEUR DE PATHS
+   ========================================================= */
+
+void MonteCarloPricer::set_precision(Precision precision)
+{
+    precision_ = precision;
+}
+
+MCPrecisionReport MonteCarloPricer::validate_precision() const
+{
+    // Mêmes tirages dans les deux précisions : l'écart mesure uniquement
+    // l'erreur d'arrondi du moteur float
+    MonteCarloPricer single(*this);
+    MonteCarloPricer dbl(*this);
+    single.precision_ = Precision::Single;
+    dbl.precision_ = Precision::Double;
+
+    std::vector<const Payoff*> payoffs{&option_.payoff()};
+    MCResult r_single = single.simulate_batches(payoffs).front();
+    MCResult r_double = dbl.simulate_batches(payoffs).front();
+
+    MCPrecisionReport report;
+    report.price_double = r_double.price;
+    report.price_single = r_single.price;
+    report.difference = r_single.price - r_double.price;
+    report.std_error = r_double.std_error;
+    report.difference_in_std_errors = (r_double.std_error > 0.0)
+        ? std::abs(report.difference) / r_double.std_error
+        : 0.0;
+
+    return report;
+}
+
+/* =========================================================
+   STOCKAGE PERSISTANT DES PATHS
+   ========================================================= */
+
+void MonteCarloPricer::write_path_store(const std::string& filename) const
+{
+    if (precision_ == Precision::Single)
+        write_paths<float>(filename);
+    else
+        write_paths<double>(filename);
+}
+
+template <typename Real>
+void MonteCarloPricer::write_paths(const std::string& filename) const
+{
+    double shift = importance_shift();
+    std::size_t batches = std::min<std::size_t>(paths_, batch_count_);
+
+    std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+    if (!file.is_open())
+        throw std::runtime_error("Cannot open file: " + filename);
+
+    PathStoreHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, "OPPATHS", 8);
+    header.version = PathStore::kVersion;
+    header.value_size = sizeof(Real);
+    header.seed = seed_;
+    header.steps = steps_;
+    header.batches = batches;
+    header.spot = S0_;
+    header.rate = r_;
+    header.carry = b_;
+    header.volatility = sigma_;
+    header.maturity = option_.maturity();
+    header.drift_shift = shift;
+    header.sampling = static_cast<std::uint32_t>(sampling_);
+    header.flags = (use_antithetic_ ? 1u : 0u) | (moment_matching_ ? 2u : 0u);
+    header.layout = 0;
+
+    // En-tête et tailles de lots réécrits à la fin, une fois les lots connus
+    std::vector<std::uint64_t> batch_rows(batches, 0);
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(batch_rows.data()),
+               static_cast<std::streamsize>(batches * sizeof(std::uint64_t)));
+
+    // Mêmes lots et mêmes tirages que le moteur par lots
+    std::vector<Real> randoms, row(steps_ + 1);
+    std::vector<double> path(steps_ + 1), weights;
+
+    for (std::size_t k = 0; k < batches; ++k)
+    {
+        std::size_t size = paths_ / batches + (k < paths_ % batches ? 1 : 0);
+
+        std::seed_seq seq{seed_, static_cast<unsigned>(k)};
+        std::mt19937 gen(seq);
+
+        std::size_t rows = generate_batch(gen, size, randoms);
+        batch_rows[k] = rows;
+
+        for (std::size_t i = 0; i < rows; ++i)
+        {
+            weights.push_back(build_path(&randoms[i * steps_], shift, path));
+            for (std::size_t j = 0; j <= steps_; ++j)
+                row[j] = static_cast<Real>(path[j]);
+            file.write(reinterpret_cast<const char*>(row.data()),
+                       static_cast<std::streamsize>(row.size() * sizeof(Real)));
+        }
+    }
+
+    file.write(reinterpret_cast<const char*>(weights.data()),
+               static_cast<std::streamsize>(weights.size() * sizeof(double)));
+
+    header.paths = weights.size();
+    file.seekp(0);
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(batch_rows.data()),
+               static_cast<std::streamsize>(batches * sizeof(std::uint64_t)));
+
+    if (!file)
+        throw std::runtime_error("Error while writing path store: " + filename);
+}
+
+/* =========================================================
+   RUNS RÉPARTIS (SHARDING PAR SOUS-FLUX)
+   ========================================================= */
+
+void MonteCarloPricer::set_batch_count(std::size_t batches)
+{
+    if (batches < 2)
+        throw std::invalid_argument("Batch engine needs at least 2 batches");
+    batch_count_ = batches;
+}
+
+MCAccumulator MonteCarloPricer::run_shard(std::size_t shard, std::size_t shard_count) const
+{
+    if (shard_count == 0 || shard >= shard_count)
+        throw std::invalid_argument("Invalid shard index");
+
+    return accumulate({&option_.payoff()}, shard, shard_count);
+}
+
+MCResult MonteCarloPricer::price_sharded(std::size_t workers) const
+{
+    if (workers == 0)
+        throw std::invalid_argument("Number of workers must be positive");
+
+    // Pré-passe pilote faite une fois avant le fork (héritée par les workers)
+    importance_shift();
+
+#ifdef _WIN32
+    MCAccumulator acc = run_shard(0, workers);
+    for (std::size_t w = 1; w < workers; ++w)
+        acc.merge(run_shard(w, workers));
+    return acc.results().front();
+#else
+    std::vector<pid_t> pids;
+    std::vector<int> pipes;
+
+    for (std::size_t w = 0; w < workers; ++w)
+    {
+        int fd[2];
+        if (pipe(fd) != 0)
+            throw std::runtime_error("Cannot create pipe for worker");
+
+        pid_t pid = fork();
+        if (pid < 0)
+            throw std::runtime_error("Cannot fork worker process");
+
+        if (pid == 0)
+        {
+            // Worker : calcule sa partie et renvoie l'accumulateur sérialisé
+            close(fd[0]);
+            int status = 0;
+            try
+            {
+                std::string data = run_shard(w, workers).to_string();
+                std::size_t written = 0;
+                while (written < data.size())
+                {
+                    ssize_t n = write(fd[1], data.data() + written, data.size() - written);
+                    if (n <= 0)
+                    {
+                        status = 1;
+                        break;
+                    }
+                    written += static_cast<std::size_t>(n);
+                }
+            }
+            catch (...)
+            {
+                status = 1;
+            }
+            close(fd[1]);
+            _exit(status);
+        }
+
+        close(fd[1]);
+        pids.push_back(pid);
+        pipes.push_back(fd[0]);
+    }
+
+    // Lecture des résultats puis fusion
+    std::vector<std::string> outputs(workers);
+    for (std::size_t w = 0; w < workers; ++w)
+    {
+        char buffer[4096];
+        ssize_t n;
+        while ((n = read(pipes[w], buffer, sizeof(buffer))) > 0)
+            outputs[w].append(buffer, static_cast<std::size_t>(n));
+        close(pipes[w]);
+    }
+
+    bool failed = false;
+    for (pid_t pid : pids)
+    {
+        int status = 0;
+        if (waitpid(pid, &status, 0) < 0 || !WIFEXITED(status) || WEXITSTATUS(status) != 0)
+            failed = true;
+    }
+    if (failed)
+        throw std::runtime_error("Monte Carlo worker process failed");
+
+    MCAccumulator acc = MCAccumulator::from_string(outputs[0]);
+    for (std::size_t w = 1; w < workers; ++w)
+        acc.merge(MCAccumulator::from_string(outputs[w]));
+
+    return acc.results().front();
+#endif
+}
+
+/* =========================================================
+   PORTEFEUILLE SUR PATHS PARTAGÉS
+   ========================================================= */
+
+std::vector<MCResult> MonteCarloPricer::price_portfolio(const std::vector<Option>& options) const
+{
+    if (options.empty())
+        throw std::invalid_argument("Portfolio must contain at least one option");
+
+    // Même grille temporelle pour tous les produits
+    std::vector<const Payoff*> payoffs;
+    payoffs.reserve(options.size());
+    for (const auto& opt : options)
+    {
+        if (std::abs(opt.maturity() - option_.maturity()) > 1e-12)
+            throw std::invalid_argument("All portfolio options must share the pricer maturity");
+        payoffs.push_back(&opt.payoff());
+    }
+
+    return simulate_batches(payoffs);
+}
+
+template <typename Real>
+std::size_t MonteCarloPricer::generate_batch(std::mt19937& gen,
+                                             std::size_t size,
+                                             std::vector<Real>& randoms) const
+{
     std::normal_distribution<> N(0.0, 1.0);
-    
+    std::uniform_real_distribution<> U(0.0, 1.0);
+
+    // Avec antithétiques, on génère la moitié des lignes puis leur miroir
+    std::size_t m = use_antithetic_ ? (size + 1) / 2 : size;
+    std::size_t rows = use_antithetic_ ? 2 * m : m;
+    double dm = static_cast<double>(m);
+
+    // Tirages toujours calculés en double puis stockés en Real : les deux
+    // précisions voient exactement les mêmes nombres aléatoires
+    randoms.assign(rows * steps_, Real(0));
+
+    switch (sampling_)
+    {
+    case SamplingScheme::Standard:
+        for (std::size_t i = 0; i < m * steps_; ++i)
+            randoms[i] = static_cast<Real>(N(gen));
+        break;
+
+    case SamplingScheme::Stratified:
+        // Strate i pour le brownien terminal, pont brownien pour l'intérieur
+        for (std::size_t i = 0; i < m; ++i)
+        {
+            double G = inverse_normal_cdf((static_cast<double>(i) + U(gen)) / dm);
+            Real* z = &randoms[i * steps_];
+
+            // Somme restante des incréments normalisés : sum(Z) = sqrt(n) * G
+            double remaining = std::sqrt(static_cast<double>(steps_)) * G;
+            for (std::size_t j = 0; j + 1 < steps_; ++j)
+            {
+                double left = static_cast<double>(steps_ - j);
+                z[j] = static_cast<Real>(remaining / left + std::sqrt((left - 1.0) / left) * N(gen));
+                remaining -= z[j];
+            }
+            z[steps_ - 1] = static_cast<Real>(remaining);
+        }
+        break;
+
+    case SamplingScheme::LatinHypercube:
+    {
+        // Une permutation indépendante des strates par dimension
+        std::vector<std::size_t> perm(m);
+        for (std::size_t j = 0; j < steps_; ++j)
+        {
+            std::iota(perm.begin(), perm.end(), 0);
+            std::shuffle(perm.begin(), perm.end(), gen);
+            for (std::size_t i = 0; i < m; ++i)
+                randoms[i * steps_ + j] = static_cast<Real>(
+                    inverse_normal_cdf((static_cast<double>(perm[i]) + U(gen)) / dm));
+        }
+        break;
+    }
+
+    default:
+        throw std::runtime_error("Unknown sampling scheme");
+    }
+
+    if (use_antithetic_)
+        for (std::size_t i = 0; i < m * steps_; ++i)
+            randoms[m * steps_ + i] = -randoms[i];
+
+    // Moment matching : moyenne 0 et variance 1 exactes par dimension
+    if (moment_matching_ && rows > 1)
+    {
+        double dr = static_cast<double>(rows);
+        for (std::size_t j = 0; j < steps_; ++j)
+        {
+            double s = 0.0, s2 = 0.0;
+            for (std::size_t i = 0; i < rows; ++i)
+            {
+                double z = randoms[i * steps_ + j];
+                s += z;
+                s2 += z * z;
+            }
+            double mean = s / dr;
+            double var = s2 / dr - mean * mean;
+            if (var <= 0.0)
+                continue;
+
+            double inv_std = 1.0 / std::sqrt(var);
+            for (std::size_t i = 0; i < rows; ++i)
+                randoms[i * steps_ + j] = static_cast<Real>((randoms[i * steps_ + j] - mean) * inv_std);
+        }
+    }
+
+    return rows;
+}
+
+double MonteCarloPricer::find_optimal_shift() const
+{
+    // Tirages communs pour tous les shifts candidats : les comparaisons sont
+    // ainsi peu bruitées. Générateur distinct de la passe principale.
+    std::mt19937 gen(seed_ ^ 0x9e3779b9u);
+    std::normal_distribution<> N(0.0, 1.0);
+
+    std::vector<double> pilot(is_pilot_paths_ * steps_);
+    for (auto& z : pilot)
+        z = N(gen);
+
     std::vector<double> path(steps_ + 1);
-    path[0] = S0_;
 
-    for (std::size_t j = 1; j <= steps_; ++j)
+    // Variance relative Var(f·L) / E[f·L]² sous la mesure décalée
+    auto relative_variance = [&](double shift)
     {
-        double Z = N(gen);
-        path[j] = path[j - 1] * std::exp(
-            (b_ - 0.5 * sigma_ * sigma_) * dt
-            + sigma_ * std::sqrt(dt) * Z
-        );
+        double sum = 0.0, sum_sq = 0.0;
+        std::size_t hits = 0;
+
+        for (std::size_t i = 0; i < is_pilot_paths_; ++i)
+        {
+            double likelihood = build_path(&pilot[i * steps_], shift, path);
+            double x = option_.payoff()(path) * likelihood;
+            sum += x;
+            sum_sq += x * x;
+            if (x != 0.0)
+                ++hits;
+        }
+
+        // Trop peu de paths dans la zone d'exercice : estimation non fiable
+        if (hits < 10)
+            return std::numeric_limits<double>::infinity();
+
+        double n = static_cast<double>(is_pilot_paths_);
+        double mean = sum / n;
+        return (sum_sq / n - mean * mean) / (mean * mean);
+    };
+
+    double best_shift = 0.0;
+    double best_value = relative_variance(0.0);
+
+    // Grille grossière puis raffinement autour du meilleur candidat
+    for (double shift = -5.0; shift <= 5.0; shift += 0.5)
+    {
+        double value = relative_variance(shift);
+        if (value < best_value)
+        {
+            best_value = value;
+            best_shift = shift;
+        }
     }
 
-    return path;
+    double center = best_shift;
+    for (double shift = center - 0.4; shift <= center + 0.4; shift += 0.1)
+    {
+        double value = relative_variance(shift);
+        if (value < best_value)
+        {
+            best_value = value;
+            best_shift = shift;
+        }
+    }
+
+    return best_shift;
 }
 
+/* =========================================================
+   FONCTIONS PRIVÉES
+   ========================================================= */
+
 std::vector<double> MonteCarloPricer::simulate_path_with_randoms(
     const std::vector<double>& randoms) const
 {
@@ -246,4 +687,83 @@ std::vector<double> MonteCarloPricer::simulate_path_with_randoms(
     }
 
     return path;
+}
+
+template <typename Real>
+double MonteCarloPricer::build_path(const Real* randoms,
+                                    double shift,
+                                    std::vector<double>& path) const
+{
+    // Décalage par pas : le brownien terminal normalisé est décalé de shift
+    double theta = shift / std::sqrt(static_cast<double>(steps_));
+
+    double dt = option_.maturity() / static_cast<double>(steps_);
+
+    // État du path en précision Real, vraisemblance accumulée en double
+    const Real drift = static_cast<Real>((b_ - 0.5 * sigma_ * sigma_) * dt);
+    const Real vol = static_cast<Real>(sigma_ * std::sqrt(dt));
+    const Real theta_r = static_cast<Real>(theta);
+
+    double sum_z = 0.0;
+    Real S = static_cast<Real>(S0_);
+    path[0] = S0_;
+    for (std::size_t j = 1; j <= steps_; ++j)
+    {
+        Real z = randoms[j - 1] + theta_r;
+        sum_z += z;
+        S *= std::exp(drift + vol * z);
+        path[j] = S;
+    }
+
+    if (theta == 0.0)
+        return 1.0;
+
+    // Vraisemblance dP/dQ = exp(-theta * sum(Z) + n * theta² / 2)
+    return std::exp(-theta * sum_z
+                    + 0.5 * static_cast<double>(steps_) * theta * theta);
+}
+
+double MonteCarloPricer::inverse_normal_cdf(double u)
+{
+    // Algorithme d'Acklam + une itération de Halley (précision ~1e-15)
+    static const double a[] = {-3.969683028665376e+01, 2.209460984245205e+02,
+                               -2.759285104469687e+02, 1.383577518672690e+02,
+                               -3.066479806614716e+01, 2.506628277459239e+00};
+    static const double b[] = {-5.447609879822406e+01, 1.615858368580409e+02,
+                               -1.556989798598866e+02, 6.680131188771972e+01,
+                               -1.328068155288572e+01};
+    static const double c[] = {-7.784894002430293e-03, -3.223964580411365e-01,
+                               -2.400758277161838e+00, -2.549732539343734e+00,
+                               4.374664141464968e+00, 2.938163982698783e+00};
+    static const double d[] = {7.784695709041462e-03, 3.224671290700398e-01,
+                               2.445134137142996e+00, 3.754408661907416e+00};
+    static const double p_low = 0.02425;
+
+    u = std::min(std::max(u, 1e-300), 1.0 - 1e-16);
+
+    double x;
+    if (u < p_low)
+    {
+        double q = std::sqrt(-2.0 * std::log(u));
+        x = (((((c[0] * q + c[1]) * q + c[2]) * q + c[3]) * q + c[4]) * q + c[5])
+          / ((((d[0] * q + d[1]) * q + d[2]) * q + d[3]) * q + 1.0);
+    }
+    else if (u <= 1.0 - p_low)
+    {
+        double q = u - 0.5;
+        double r = q * q;
+        x = (((((a[0] * r + a[1]) * r + a[2]) * r + a[3]) * r + a[4]) * r + a[5]) * q
+          / (((((b[0] * r + b[1]) * r + b[2]) * r + b[3]) * r + b[4]) * r + 1.0);
+    }
+    else
+    {
+        double q = std::sqrt(-2.0 * std::log(1.0 - u));
+        x = -(((((c[0] * q + c[1]) * q + c[2]) * q + c[3]) * q + c[4]) * q + c[5])
+          / ((((d[0] * q + d[1]) * q + d[2]) * q + d[3]) * q + 1.0);
+    }
+
+    // Raffinement de Halley
+    double e = 0.5 * std::erfc(-x / std::sqrt(2.0)) - u;
+    double v = e * 2.5066282746310002 * std::exp(0.5 * x * x);
+    return x - v / (1.0 + 0.5 * x * v);
 }
\ No newline at end of file
@@ -2,18 +2,21 @@
 
 #include "pricer.hpp"
 #include "option.hpp"
+#include "mc_accumulator.hpp"
 #include <vector>
 #include <random>
+#include <string>
 
 /* =========================================================
-   STRUCTURE POUR RÉSULTATS MONTE CARLO
+   VALIDATION DE LA PRÉCISION FLOAT / DOUBLE
    ========================================================= */
-struct MCResult
+struct MCPrecisionReport
 {
-    double price;
-    double std_error;
-    double ci_lower_95;  // Intervalle de confiance à 95%
-    double ci_upper_95;
+    double price_double;
+    double price_single;
+    double difference;                // price_single - price_double
+    double std_error;                 // Erreur standard MC (run double)
+    double difference_in_std_errors;  // |difference| / std_error
 };
 
 /* =========================================================
@@ -22,6 +25,19 @@ struct MCResult
 class MonteCarloPricer : public Pricer
 {
 public:
+    enum class SamplingScheme
+    {
+        Standard,       // Tirages i.i.d.
+        Stratified,     // Brownien terminal stratifié + pont brownien
+        LatinHypercube  // Hypercube latin sur les dimensions du path
+    };
+
+    // Précision de l'état des paths (l'accumulation reste en double)
+    enum class Precision
+    {
+        Double,
+        Single
+    };
 
     MonteCarloPricer(const Option& option,
                      double spot,
@@ -45,16 +61,116 @@ public:
     // Vega par Monte Carlo
     double vega() const override;
 
-private:
-    // Simuler un path complet
-    std::vector<double> simulate_path(std::mt19937& gen) const; // On passe le générateur pour éviter de le recréer à chaque fois
+    // Échantillonnage préférentiel (importance sampling) par décalage de drift.
+    // Le shift est exprimé en unités du brownien terminal normalisé W_T / sqrt(T) :
+    // chaque pas reçoit Z + shift / sqrt(steps) et le payoff est pondéré par la
+    // vraisemblance de Girsanov L = exp(-shift * W + shift² / 2).
+    void enable_importance_sampling(double drift_shift);
+    
+    // Shift optimal déterminé par une pré-passe pilote (minimise la variance relative)
+    void enable_importance_sampling_auto(std::size_t pilot_paths = 1000);
+    
+    void disable_importance_sampling();
     
+    // Shift effectivement utilisé (0 si désactivé)
+    double importance_shift() const;
+
+    // Schéma d'échantillonnage des incréments browniens
+    void set_sampling_scheme(SamplingScheme scheme);
+    SamplingScheme sampling_scheme() const { return sampling_; }
+    
+    // Moment matching (moyenne / variance) des tirages normaux par lot
+    void set_moment_matching(bool enabled);
+
+    // Pricing d'un portefeuille sur un seul jeu de paths simulés : les options
+    // (strikes, barrières, styles différents) doivent partager la maturité du pricer.
+    // Renvoie un résultat par option, dans l'ordre.
+    std::vector<MCResult> price_portfolio(const std::vector<Option>& options) const;
+
+    // Nombre de lots (sous-flux RNG indépendants) du moteur par lots
+    void set_batch_count(std::size_t batches);
+    std::size_t batch_count() const { return batch_count_; }
+
+    // Calcul d'une partie du run : lots k tels que k % shard_count == shard.
+    // Les accumulateurs de toutes les parties fusionnés donnent exactement le run complet.
+    MCAccumulator run_shard(std::size_t shard, std::size_t shard_count) const;
+    
+    // Run réparti sur plusieurs processus (fork) puis fusionné.
+    // Sans fork (Windows), les parties sont calculées séquentiellement.
+    MCResult price_sharded(std::size_t workers) const;
+
+    // Précision du moteur de paths : Single divise par deux la mémoire des
+    // tirages et double la largeur SIMD, les payoffs restent accumulés en double
+    void set_precision(Precision precision);
+    Precision precision() const { return precision_; }
+    
+    // Lance le moteur en float et en double sur les mêmes tirages et compare
+    // l'écart de prix à l'erreur standard MC
+    MCPrecisionReport validate_precision() const;
+
+    // Écrit les paths du moteur par lots (configuration courante) dans un
+    // fichier binaire relisible par PathStore, pour rejouer les scénarios
+    void write_path_store(const std::string& filename) const;
+
+private:
     // Simuler un path avec des nombres aléatoires spécifiques
     std::vector<double> simulate_path_with_randoms(const std::vector<double>& randoms) const;
 
+    // Construit le path pour des tirages décalés de shift (path est un buffer
+    // réutilisé) et renvoie la vraisemblance de Girsanov associée
+    template <typename Real>
+    double build_path(const Real* randoms,
+                      double shift,
+                      std::vector<double>& path) const;
+    
+    // Moteur par lots (seul moteur de paths) : importance sampling,
+    // stratification, LHS, moment matching, sous-flux par lot pour le sharding.
+    // Chaque path simulé est évalué pour tous les payoffs fournis.
+    std::vector<MCResult> simulate_batches(const std::vector<const Payoff*>& payoffs) const;
+    MCAccumulator accumulate(const std::vector<const Payoff*>& payoffs,
+                             std::size_t shard,
+                             std::size_t shard_count) const;
+    
+    // Moteur instancié pour la précision Real de l'état (float ou double)
+    template <typename Real>
+    MCAccumulator accumulate_impl(const std::vector<const Payoff*>& payoffs,
+                                  std::size_t shard,
+                                  std::size_t shard_count) const;
+    
+    // Tirages normaux d'un lot (lignes × steps), renvoie le nombre de lignes
+    template <typename Real>
+    std::size_t generate_batch(std::mt19937& gen,
+                               std::size_t size,
+                               std::vector<Real>& randoms) const;
+    
+    template <typename Real>
+    void write_paths(const std::string& filename) const;
+    
+    // Inverse de la fonction de répartition normale
+    static double inverse_normal_cdf(double u);
+    
+    // Pré-passe pilote pour le shift optimal
+    double find_optimal_shift() const;
+
     const Option& option_;
     double S0_, r_, b_, sigma_;
     std::size_t paths_, steps_;
     unsigned seed_;
     bool use_antithetic_;  // Variables antithétiques pour réduction de variance
+
+    // Importance sampling
+    bool is_enabled_;
+    bool is_auto_;
+    double is_shift_;
+    std::size_t is_pilot_paths_;
+    mutable bool is_shift_cached_;  // Shift automatique mis en cache après la pré-passe
+    mutable double is_cached_shift_;
+
+    SamplingScheme sampling_;
+    bool moment_matching_;
+    
+    // Nombre de lots indépendants pour l'estimation de l'erreur standard
+    std::size_t batch_count_;
+    
+    Precision precision_;
 };
\ No newline at end of file
@@ -0,0 +1,261 @@
+#include "path_dependent_tree_pricer.hpp"
+#include <cmath>
+#include <algorithm>
+#include <stdexcept>
+
+/* =========================================================
+   ARBRE ASIATIQUE / LOOKBACK - IMPLÉMENTATION
+   ========================================================= */
+
+PathDependentTreePricer::PathDependentTreePricer(const Option& option,
+                                                 double spot,
+                                                 double rate,
+                                                 double carry,
+                                                 double volatility,
+                                                 std::size_t steps,
+                                                 bool is_american,
+                                                 std::size_t resolution)
+    : option_(option),
+      S0_(spot),
+      r_(rate),
+      b_(carry),
+      sigma_(volatility),
+      N_(steps),
+      is_american_(is_american),
+      R_(resolution)
+{
+    // Validation
+    if (spot <= 0.0)
+        throw std::invalid_argument("Spot must be positive");
+    if (volatility <= 0.0)
+        throw std::invalid_argument("Volatility must be positive");
+    if (steps == 0)
+        throw std::invalid_argument("Number of steps must be positive");
+    if (resolution == 0)
+        throw std::invalid_argument("Grid resolution must be positive");
+
+    // Variable de chemin selon le payoff
+    if (const auto* asian = dynamic_cast<const AsianPayoff*>(&option.payoff()))
+    {
+        state_ = (asian->averaging() == AsianPayoff::Averaging::Arithmetic)
+                     ? State::ArithmeticAverage
+                     : State::GeometricAverage;
+    }
+    else if (dynamic_cast<const LookbackPayoff*>(&option.payoff()))
+    {
+        state_ = (option.payoff().type() == OptionType::Call) ? State::Maximum : State::Minimum;
+    }
+    else
+    {
+        throw std::invalid_argument("Path-dependent tree needs an Asian or lookback payoff");
+    }
+
+    // Paramètres CRR
+    double dt = option.maturity() / static_cast<double>(steps);
+    u_ = std::exp(sigma_ * std::sqrt(dt));
+    d_ = 1.0 / u_;
+    df_ = std::exp(-r_ * dt);
+    p_ = (std::exp(b_ * dt) - d_) / (u_ - d_);
+
+    if (p_ < 0.0 || p_ > 1.0)
+        throw std::runtime_error("Invalid risk-neutral probability (check parameters)");
+}
+
+double PathDependentTreePricer::update(double x, double level, double S, double log_S, std::size_t n) const
+{
+    // Variables en log : log moyenne, moyenne des log, log extrême
+    double dates = static_cast<double>(n + 1);
+
+    switch (state_)
+    {
+    case State::ArithmeticAverage:
+        return std::log((level * dates + S) / (dates + 1.0));
+    case State::GeometricAverage:
+        return (x * dates + log_S) / (dates + 1.0);
+    case State::Maximum:
+        return std::max(x, log_S);
+    case State::Minimum:
+        return std::min(x, log_S);
+    default:
+        throw std::runtime_error("Unknown path state");
+    }
+}
+
+double PathDependentTreePricer::exercise(double level, double S) const
+{
+    const Payoff& payoff = option_.payoff();
+
+    if (state_ == State::ArithmeticAverage || state_ == State::GeometricAverage)
+        return payoff.payoff_spot(level);
+
+    return static_cast<const LookbackPayoff&>(payoff).payoff_extremum(level, S);
+}
+
+double PathDependentTreePricer::price() const
+{
+    return price_at(S0_);
+}
+
+double PathDependentTreePricer::price_at(double spot) const
+{
+    std::size_t N = N_;
+
+    // Spot au nœud (i, n) : spot u^i d^(n - i), et son log
+    std::vector<double> powers(2 * N + 1), log_powers(2 * N + 1);
+    for (std::size_t j = 0; j <= 2 * N; ++j)
+    {
+        log_powers[j] = std::log(spot) + (static_cast<double>(j) - static_cast<double>(N)) * std::log(u_);
+        powers[j] = std::exp(log_powers[j]);
+    }
+    auto S = [&](std::size_t i, std::size_t n) { return powers[N + 2 * i - n]; };
+    auto log_S = [&](std::size_t i, std::size_t n) { return log_powers[N + 2 * i - n]; };
+
+    // Grille commune de la variable (en log) : x0 + m h, h = log(u) / resolution.
+    // Pour les lookbacks, les extrêmes de l'arbre tombent exactement sur la grille
+    double x0 = std::log(spot);
+    double h = std::log(u_) / static_cast<double>(R_);
+
+    // Plage d'indices [first, last] de la grille à chaque nœud, qui couvre les
+    // valeurs atteignables (propagation avant des bornes : la mise à jour est
+    // croissante en x). Stockage triangulaire, nœud (i, n) en n(n+1)/2 + i
+    auto node = [](std::size_t i, std::size_t n) { return n * (n + 1) / 2 + i; };
+    std::vector<double> lo(node(0, N + 1)), hi(node(0, N + 1));
+    std::vector<long> first(node(0, N + 1)), last(node(0, N + 1));
+
+    lo[0] = hi[0] = x0;
+    for (std::size_t n = 0; n < N; ++n)
+    {
+        for (std::size_t i = 0; i <= n + 1; ++i)
+        {
+            double S_next = S(i, n + 1);
+            double log_next = log_S(i, n + 1);
+            double low = HUGE_VAL, high = -HUGE_VAL;
+            auto step = [&](double x) { return update(x, std::exp(x), S_next, log_next, n); };
+
+            if (i <= n)  // Depuis (i, n) par une baisse
+            {
+                low = std::min(low, step(lo[node(i, n)]));
+                high = std::max(high, step(hi[node(i, n)]));
+            }
+            if (i > 0)   // Depuis (i - 1, n) par une hausse
+            {
+                low = std::min(low, step(lo[node(i - 1, n)]));
+                high = std::max(high, step(hi[node(i - 1, n)]));
+            }
+
+            lo[node(i, n + 1)] = low;
+            hi[node(i, n + 1)] = high;
+        }
+    }
+
+    for (std::size_t j = 0; j < lo.size(); ++j)
+    {
+        // Tolérance : une borne sur un point de grille ne crée pas de point de plus
+        first[j] = static_cast<long>(std::floor((lo[j] - x0) / h + 1e-9));
+        last[j] = static_cast<long>(std::ceil((hi[j] - x0) / h - 1e-9));
+        last[j] = std::max(last[j], first[j]);
+    }
+
+    // Niveaux exp(x0 + m h) de la grille, tabulés une fois
+    long m_min = *std::min_element(first.begin(), first.end());
+    long m_max = *std::max_element(last.begin(), last.end());
+    std::vector<double> levels(static_cast<std::size_t>(m_max - m_min + 1));
+    for (std::size_t j = 0; j < levels.size(); ++j)
+        levels[j] = std::exp(x0 + static_cast<double>(static_cast<long>(j) + m_min) * h);
+
+    // Valeurs d'un pas : états du nœud i à partir de offset[i]
+    auto layout = [&](std::size_t n, std::vector<std::size_t>& offset)
+    {
+        offset.resize(n + 2);
+        offset[0] = 0;
+        for (std::size_t i = 0; i <= n; ++i)
+            offset[i + 1] = offset[i] + static_cast<std::size_t>(last[node(i, n)] - first[node(i, n)] + 1);
+    };
+
+    // Interpolation linéaire en x de la valeur au nœud (i, n)
+    auto interpolate = [&](const std::vector<double>& values, const std::vector<std::size_t>& offset,
+                           std::size_t i, std::size_t n, double x)
+    {
+        const double* v = values.data() + offset[i];
+        std::size_t count = offset[i + 1] - offset[i];
+        if (count == 1)
+            return v[0];
+
+        double top = static_cast<double>(count - 1);
+        double t = std::clamp((x - x0) / h - static_cast<double>(first[node(i, n)]), 0.0, top);
+        if (count == 2)
+            return (1.0 - t) * v[0] + t * v[1];
+
+        // Lagrange sur les trois points les plus proches
+        std::size_t j = std::clamp<std::size_t>(static_cast<std::size_t>(t + 0.5), 1, count - 2);
+        double w = t - static_cast<double>(j);
+        return 0.5 * w * (w - 1.0) * v[j - 1] + (1.0 - w * w) * v[j] + 0.5 * w * (w + 1.0) * v[j + 1];
+    };
+
+    // Condition terminale : payoff sur chaque valeur représentative
+    std::vector<std::size_t> next_offset, offset;
+    std::vector<double> next, current;
+
+    layout(N, next_offset);
+    next.resize(next_offset[N + 1]);
+    for (std::size_t i = 0; i <= N; ++i)
+    {
+        const double* level = levels.data() + (first[node(i, N)] - m_min);
+        for (std::size_t k = next_offset[i]; k < next_offset[i + 1]; ++k)
+            next[k] = exercise(level[k - next_offset[i]], S(i, N));
+    }
+
+    // Remontée : chaque état suit sa variable mise à jour vers les deux successeurs
+    double up = df_ * p_;
+    double down = df_ * (1.0 - p_);
+
+    for (std::size_t n = N; n-- > 0;)
+    {
+        layout(n, offset);
+        current.resize(offset[n + 1]);
+
+        for (std::size_t i = 0; i <= n; ++i)
+        {
+            double S_up = S(i + 1, n + 1), log_up = log_S(i + 1, n + 1);
+            double S_down = S(i, n + 1), log_down = log_S(i, n + 1);
+            double S_here = S(i, n);
+            long m0 = first[node(i, n)];
+            const double* level = levels.data() + (m0 - m_min);
+
+            for (std::size_t k = offset[i]; k < offset[i + 1]; ++k)
+            {
+                std::size_t m = k - offset[i];
+                double x = x0 + static_cast<double>(m0 + static_cast<long>(m)) * h;
+                double value = up * interpolate(next, next_offset, i + 1, n + 1, update(x, level[m], S_up, log_up, n))
+                             + down * interpolate(next, next_offset, i, n + 1, update(x, level[m], S_down, log_down, n));
+
+                if (is_american_)
+                    value = std::max(value, exercise(level[m], S_here));
+
+                current[k] = value;
+            }
+        }
+
+        next.swap(current);
+        next_offset.swap(offset);
+    }
+
+    // Racine : l'état x0 est le point 0 de la grille
+    return next[0];
+}
+
+/* =========================================================
+   GREEKS PAR DIFFÉRENCES CENTRÉES
+   ========================================================= */
+
+double PathDependentTreePricer::delta(double spot) const
+{
+    double h = kBump * spot;
+    return (price_at(spot + h) - price_at(spot - h)) / (2.0 * h);
+}
+
+double PathDependentTreePricer::gamma(double spot) const
+{
+    double h = kBump * spot;
+    return (price_at(spot + h) - 2.0 * price_at(spot) + price_at(spot - h)) / (h * h);
+}
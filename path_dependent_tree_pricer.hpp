@@ -0,0 +1,75 @@
+#pragma once
+
+#include "pricer.hpp"
+#include "option.hpp"
+#include <vector>
+
+/* =========================================================
+   ARBRE BINOMIAL – OPTIONS ASIATIQUES ET LOOKBACK
+   ========================================================= */
+
+// Arbre CRR où chaque nœud porte une grille de valeurs représentatives de
+// la variable de chemin (moyenne courante ou extrême courant) : points
+// log-espacés x0 + m h communs à tout l'arbre, limités à la plage atteignable
+// au nœud (Hull-White). La remontée interpole la valeur des successeurs en
+// la variable mise à jour (Lagrange à trois points plutôt que linéaire :
+// l'erreur d'interpolation devient négligeable dès resolution = 4). Avec
+// h = log(u) / resolution, les extrêmes de l'arbre sont des points de la
+// grille : les lookbacks sont exacts sur l'arbre. La moyenne porte sur les
+// steps + 1 dates de l'arbre, S0 compris, comme les paths Monte Carlo de même
+// nombre de pas. Exercice européen ou américain (sur la moyenne ou
+// l'extrême courant).
+class PathDependentTreePricer : public Pricer
+{
+public:
+    PathDependentTreePricer(const Option& option,
+                            double spot,
+                            double rate,
+                            double carry,
+                            double volatility,
+                            std::size_t steps,
+                            bool is_american = false,
+                            std::size_t resolution = 4);  // Points de grille par pas log(u)
+
+    double price() const override;
+
+    // Greeks par différences centrées sur des arbres déterministes (lisses)
+    double delta(double spot) const override;
+    double gamma(double spot) const override;
+
+    std::size_t get_steps() const { return N_; }
+    std::size_t get_resolution() const { return R_; }
+
+private:
+    // Variable de chemin suivie sur l'arbre
+    enum class State
+    {
+        ArithmeticAverage,  // log de la moyenne arithmétique
+        GeometricAverage,   // Moyenne des log-spots
+        Maximum,            // log du maximum courant
+        Minimum             // log du minimum courant
+    };
+
+    // Prix pour un spot initial donné
+    double price_at(double spot) const;
+
+    // Variable x (en log, level = exp(x)) après un pas vers le spot S
+    // (n + 1 dates déjà observées)
+    double update(double x, double level, double S, double log_S, std::size_t n) const;
+
+    // Payoff (ou valeur d'exercice) pour la moyenne ou l'extrême level et le spot S
+    double exercise(double level, double S) const;
+
+    // Écart relatif du spot pour delta et gamma
+    static constexpr double kBump = 1e-2;
+
+    const Option& option_;
+    double S0_, r_, b_, sigma_;
+    std::size_t N_;
+    bool is_american_;
+    std::size_t R_;
+    State state_;
+
+    // Paramètres CRR
+    double u_, d_, p_, df_;
+};
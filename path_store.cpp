@@ -0,0 +1,182 @@
+#include "path_store.hpp"
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+#ifndef _WIN32
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+/* =========================================================
+   PATH STORE - IMPLÉMENTATION
+   ========================================================= */
+
+PathStore::PathStore(const std::string& filename)
+    : data_(nullptr),
+      size_(0),
+      batch_rows_(nullptr),
+      values_(nullptr),
+      weights_(nullptr)
+{
+#ifdef _WIN32
+    std::ifstream file(filename, std::ios::binary | std::ios::ate);
+    if (!file.is_open())
+        throw std::runtime_error("Cannot open file: " + filename);
+
+    size_ = static_cast<std::size_t>(file.tellg());
+    buffer_.resize(size_);
+    file.seekg(0);
+    file.read(buffer_.data(), static_cast<std::streamsize>(size_));
+    data_ = buffer_.data();
+#else
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0)
+        throw std::runtime_error("Cannot open file: " + filename);
+
+    struct stat st;
+    if (fstat(fd, &st) != 0)
+    {
+        close(fd);
+        throw std::runtime_error("Cannot stat file: " + filename);
+    }
+    size_ = static_cast<std::size_t>(st.st_size);
+
+    if (size_ < sizeof(PathStoreHeader))
+    {
+        close(fd);
+        throw std::runtime_error("File too small for a path store: " + filename);
+    }
+
+    // Mapping partagé en lecture seule : le fd peut être fermé ensuite
+    void* addr = mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (addr == MAP_FAILED)
+        throw std::runtime_error("Cannot map file: " + filename);
+    data_ = static_cast<const char*>(addr);
+#endif
+
+    if (size_ < sizeof(PathStoreHeader))
+        throw std::runtime_error("File too small for a path store: " + filename);
+
+    std::memcpy(&header_, data_, sizeof(PathStoreHeader));
+
+    // Validation de l'en-tête et de la taille
+    std::size_t n = paths();
+    std::size_t width = steps() + 1;
+    std::size_t expected = sizeof(PathStoreHeader)
+                         + header_.batches * sizeof(std::uint64_t)
+                         + n * width * header_.value_size
+                         + n * sizeof(double);
+
+    bool valid = std::strncmp(header_.magic, "OPPATHS", 8) == 0
+              && header_.version == kVersion
+              && (header_.value_size == 4 || header_.value_size == 8)
+              && header_.layout == 0
+              && expected == size_;
+    if (!valid)
+    {
+#ifndef _WIN32
+        munmap(const_cast<char*>(data_), size_);
+#endif
+        throw std::runtime_error("Invalid or corrupted path store: " + filename);
+    }
+
+    batch_rows_ = reinterpret_cast<const std::uint64_t*>(data_ + sizeof(PathStoreHeader));
+    values_ = data_ + sizeof(PathStoreHeader) + header_.batches * sizeof(std::uint64_t);
+    weights_ = values_ + n * width * header_.value_size;
+}
+
+PathStore::~PathStore()
+{
+#ifndef _WIN32
+    if (data_)
+        munmap(const_cast<char*>(data_), size_);
+#endif
+}
+
+void PathStore::path(std::size_t i, std::vector<double>& out) const
+{
+    if (i >= paths())
+        throw std::out_of_range("Path index out of range");
+
+    std::size_t width = steps() + 1;
+    out.resize(width);
+
+    if (header_.value_size == 8)
+    {
+        std::memcpy(out.data(), values_ + i * width * sizeof(double), width * sizeof(double));
+    }
+    else
+    {
+        const char* row = values_ + i * width * sizeof(float);
+        for (std::size_t j = 0; j < width; ++j)
+        {
+            float v;
+            std::memcpy(&v, row + j * sizeof(float), sizeof(float));
+            out[j] = v;
+        }
+    }
+}
+
+double PathStore::weight(std::size_t i) const
+{
+    if (i >= paths())
+        throw std::out_of_range("Path index out of range");
+
+    double w;
+    std::memcpy(&w, weights_ + i * sizeof(double), sizeof(double));
+    return w;
+}
+
+std::vector<MCResult> PathStore::price(const std::vector<Option>& options) const
+{
+    if (options.empty())
+        throw std::invalid_argument("Portfolio must contain at least one option");
+
+    std::vector<const Payoff*> payoffs;
+    for (const auto& opt : options)
+    {
+        if (std::abs(opt.maturity() - header_.maturity) > 1e-12)
+            throw std::invalid_argument("All options must share the stored maturity");
+        payoffs.push_back(&opt.payoff());
+    }
+
+    std::size_t count = payoffs.size();
+    std::size_t batches = static_cast<std::size_t>(header_.batches);
+
+    // Mêmes lots que le run d'origine : même accumulateur, même résultat
+    MCAccumulator acc(static_cast<unsigned>(header_.seed), batches, count,
+                      std::exp(-header_.rate * header_.maturity));
+
+    std::vector<double> buffer;
+    std::size_t row = 0;
+    for (std::size_t k = 0; k < batches; ++k)
+    {
+        MCAccumulator::BatchRecord batch;
+        batch.index = k;
+        batch.count = static_cast<std::size_t>(batch_rows_[k]);
+        batch.sum.assign(count, 0.0);
+        batch.sum_plain_sq.assign(count, 0.0);
+
+        for (std::size_t i = 0; i < batch.count; ++i, ++row)
+        {
+            path(row, buffer);
+            double likelihood = weight(row);
+
+            for (std::size_t p = 0; p < count; ++p)
+            {
+                double f = (*payoffs[p])(buffer);
+                batch.sum[p] += f * likelihood;
+                batch.sum_plain_sq[p] += f * f * likelihood;
+            }
+        }
+
+        acc.add_batch(std::move(batch));
+    }
+
+    return acc.results();
+}
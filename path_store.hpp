@@ -0,0 +1,79 @@
+#pragma once
+
+#include "option.hpp"
+#include "mc_accumulator.hpp"
+#include <vector>
+#include <string>
+#include <cstdint>
+
+/* =========================================================
+   EN-TÊTE DU FICHIER DE PATHS
+   ========================================================= */
+
+// Format binaire (little-endian, natif) :
+//   [PathStoreHeader]
+//   [nombre de paths par lot : uint64 × batches]
+//   [paths : paths × (steps + 1) valeurs, path par path]
+//   [poids de vraisemblance : paths × double]
+struct PathStoreHeader
+{
+    char magic[8];              // "OPPATHS"
+    std::uint32_t version;
+    std::uint32_t value_size;   // 8 = double, 4 = float
+    std::uint64_t seed;
+    std::uint64_t paths;
+    std::uint64_t steps;
+    std::uint64_t batches;
+    double spot;
+    double rate;
+    double carry;
+    double volatility;
+    double maturity;
+    double drift_shift;         // Shift d'importance sampling (poids stockés)
+    std::uint32_t sampling;     // MonteCarloPricer::SamplingScheme
+    std::uint32_t flags;        // Bit 0 : antithétiques, bit 1 : moment matching
+    std::uint32_t layout;       // 0 : path-major
+    std::uint32_t reserved;
+};
+
+/* =========================================================
+   STOCKAGE PERSISTANT DE PATHS (MEMORY-MAPPED)
+   ========================================================= */
+
+// Ouvre un fichier écrit par MonteCarloPricer::write_path_store en lecture
+// seule et le mappe en mémoire : les paths sont relus directement depuis le
+// page cache, sans désérialisation, et plusieurs processus peuvent partager
+// le même fichier. Sans mmap (Windows), le fichier est chargé en mémoire.
+class PathStore
+{
+public:
+    static constexpr std::uint32_t kVersion = 1;
+
+    explicit PathStore(const std::string& filename);
+    ~PathStore();
+
+    PathStore(const PathStore&) = delete;
+    PathStore& operator=(const PathStore&) = delete;
+
+    const PathStoreHeader& header() const { return header_; }
+    std::size_t paths() const { return static_cast<std::size_t>(header_.paths); }
+    std::size_t steps() const { return static_cast<std::size_t>(header_.steps); }
+    double maturity() const { return header_.maturity; }
+
+    // Copie le path i dans out (steps + 1 valeurs)
+    void path(std::size_t i, std::vector<double>& out) const;
+    double weight(std::size_t i) const;
+
+    // Rejoue les paths stockés pour une liste d'options de même maturité.
+    // Résultat identique au run qui a écrit le fichier.
+    std::vector<MCResult> price(const std::vector<Option>& options) const;
+
+private:
+    PathStoreHeader header_;
+    const char* data_;       // Début du fichier mappé
+    std::size_t size_;
+    const std::uint64_t* batch_rows_;
+    const char* values_;
+    const char* weights_;    // Lu par memcpy (alignement non garanti en float)
+    std::vector<char> buffer_;  // Utilisé seulement sans mmap
+};
@@ -39,8 +39,11 @@ double Payoff::payoff_derivative(double spot) const
    OPTIONS ASIATIQUES
    ========================================================= */
 
+AsianPayoff::AsianPayoff(double strike, OptionType type, Averaging averaging)
+    : Payoff(strike, type), averaging_(averaging) {}
+
 AsianCallPayoff::AsianCallPayoff(double strike)
-    : Payoff(strike, OptionType::Call) {}
+    : AsianPayoff(strike, OptionType::Call, Averaging::Arithmetic) {}
 
 double AsianCallPayoff::operator()(const std::vector<double>& path) const
 {
@@ -50,7 +53,7 @@ double AsianCallPayoff::operator()(const std::vector<double>& path) const
 }
 
 AsianPutPayoff::AsianPutPayoff(double strike)
-    : Payoff(strike, OptionType::Put) {}
+    : AsianPayoff(strike, OptionType::Put, Averaging::Arithmetic) {}
 
 double AsianPutPayoff::operator()(const std::vector<double>& path) const
 {
@@ -60,7 +63,7 @@ double AsianPutPayoff::operator()(const std::vector<double>& path) const
 }
 
 AsianGeometricCallPayoff::AsianGeometricCallPayoff(double strike)
-    : Payoff(strike, OptionType::Call) {}
+    : AsianPayoff(strike, OptionType::Call, Averaging::Geometric) {}
 
 double AsianGeometricCallPayoff::operator()(const std::vector<double>& path) const
 {
@@ -77,7 +80,7 @@ double AsianGeometricCallPayoff::operator()(const std::vector<double>& path) con
 }
 
 AsianGeometricPutPayoff::AsianGeometricPutPayoff(double strike)
-    : Payoff(strike, OptionType::Put) {}
+    : AsianPayoff(strike, OptionType::Put, Averaging::Geometric) {}
 
 double AsianGeometricPutPayoff::operator()(const std::vector<double>& path) const
 {
@@ -95,8 +98,23 @@ double AsianGeometricPutPayoff::operator()(const std::vector<double>& path) cons
    OPTIONS LOOKBACK
    ========================================================= */
 
+LookbackPayoff::LookbackPayoff(double strike, OptionType type, StrikeStyle style)
+    : Payoff(strike, type), style_(style) {}
+
+double LookbackPayoff::payoff_extremum(double extremum, double spot) const
+{
+    if (style_ == StrikeStyle::Fixed)
+        return payoff_spot(extremum);
+
+    // Strike flottant : max - S (call), S - min (put)
+    if (type_ == OptionType::Call)
+        return std::max(extremum - spot, 0.0);
+    else
+        return std::max(spot - extremum, 0.0);
+}
+
 LookbackCallPayoff::LookbackCallPayoff(double strike)
-    : Payoff(strike, OptionType::Call) {}
+    : LookbackPayoff(strike, OptionType::Call, StrikeStyle::Fixed) {}
 
 double LookbackCallPayoff::operator()(const std::vector<double>& path) const
 {
@@ -105,7 +123,7 @@ double LookbackCallPayoff::operator()(const std::vector<double>& path) const
 }
 
 LookbackPutPayoff::LookbackPutPayoff(double strike)
-    : Payoff(strike, OptionType::Put) {}
+    : LookbackPayoff(strike, OptionType::Put, StrikeStyle::Fixed) {}
 
 double LookbackPutPayoff::operator()(const std::vector<double>& path) const
 {
@@ -114,7 +132,7 @@ double LookbackPutPayoff::operator()(const std::vector<double>& path) const
 }
 
 LookbackFloatingCallPayoff::LookbackFloatingCallPayoff()
-    : Payoff(0.0, OptionType::Call) {}
+    : LookbackPayoff(0.0, OptionType::Call, StrikeStyle::Floating) {}
 
 double LookbackFloatingCallPayoff::operator()(const std::vector<double>& path) const
 {
@@ -125,7 +143,7 @@ double LookbackFloatingCallPayoff::operator()(const std::vector<double>& path) c
 }
 
 LookbackFloatingPutPayoff::LookbackFloatingPutPayoff()
-    : Payoff(0.0, OptionType::Put) {}
+    : LookbackPayoff(0.0, OptionType::Put, StrikeStyle::Floating) {}
 
 double LookbackFloatingPutPayoff::operator()(const std::vector<double>& path) const
 {
@@ -139,8 +157,21 @@ double LookbackFloatingPutPayoff::operator()(const std::vector<double>& path) co
    OPTIONS BARRIÈRES
    ========================================================= */
 
+BarrierPayoff::BarrierPayoff(double strike, OptionType type, double barrier,
+                             Direction direction, Knock knock)
+    : Payoff(strike, type), barrier_(barrier), direction_(direction), knock_(knock)
+{
+    if (barrier <= 0.0)
+        throw std::invalid_argument("Barrier must be positive");
+}
+
+bool BarrierPayoff::is_breached(double spot) const
+{
+    return (direction_ == Direction::Up) ? spot >= barrier_ : spot <= barrier_;
+}
+
 BarrierUpOutCallPayoff::BarrierUpOutCallPayoff(double strike, double barrier)
-    : Payoff(strike, OptionType::Call), barrier_(barrier)
+    : BarrierPayoff(strike, OptionType::Call, barrier, Direction::Up, Knock::Out)
 {
     if (barrier <= strike)
         throw std::invalid_argument("Barrier must be above strike for up-and-out call");
@@ -157,7 +188,7 @@ double BarrierUpOutCallPayoff::operator()(const std::vector<double>& path) const
 }
 
 BarrierUpOutPutPayoff::BarrierUpOutPutPayoff(double strike, double barrier)
-    : Payoff(strike, OptionType::Put), barrier_(barrier)
+    : BarrierPayoff(strike, OptionType::Put, barrier, Direction::Up, Knock::Out)
 {
     if (barrier <= strike)
         throw std::invalid_argument("Barrier must be above strike for up-and-out put");
@@ -174,7 +205,7 @@ double BarrierUpOutPutPayoff::operator()(const std::vector<double>& path) const
 }
 
 BarrierDownOutPutPayoff::BarrierDownOutPutPayoff(double strike, double barrier)
-    : Payoff(strike, OptionType::Put), barrier_(barrier)
+    : BarrierPayoff(strike, OptionType::Put, barrier, Direction::Down, Knock::Out)
 {
     if (barrier >= strike)
         throw std::invalid_argument("Barrier must be below strike for down-and-out put");
@@ -191,7 +222,7 @@ double BarrierDownOutPutPayoff::operator()(const std::vector<double>& path) cons
 }
 
 BarrierUpInCallPayoff::BarrierUpInCallPayoff(double strike, double barrier)
-    : Payoff(strike, OptionType::Call), barrier_(barrier)
+    : BarrierPayoff(strike, OptionType::Call, barrier, Direction::Up, Knock::In)
 {
     if (barrier <= strike)
         throw std::invalid_argument("Barrier must be above strike for up-and-in call");
@@ -214,7 +245,7 @@ double BarrierUpInCallPayoff::operator()(const std::vector<double>& path) const
 }
 
 BarrierDownInPutPayoff::BarrierDownInPutPayoff(double strike, double barrier)
-    : Payoff(strike, OptionType::Put), barrier_(barrier)
+    : BarrierPayoff(strike, OptionType::Put, barrier, Direction::Down, Knock::In)
 {
     if (barrier >= strike)
         throw std::invalid_argument("Barrier must be below strike for down-and-in put");
@@ -308,6 +339,36 @@ double PowerPutPayoff::operator()(const std::vector<double>& path) const
     return 0.0;
 }
 
+/* =========================================================
+   OPTIONS SUR DEUX SOUS-JACENTS
+   ========================================================= */
+
+TwoAssetPayoff::TwoAssetPayoff(Style style, OptionType type, double strike)
+    : style_(style), type_(type), K_(strike)
+{
+    if (strike < 0.0)
+        throw std::invalid_argument("Strike must be non-negative");
+}
+
+double TwoAssetPayoff::operator()(double spot1, double spot2) const
+{
+    double phi = (type_ == OptionType::Call) ? 1.0 : -1.0;
+
+    switch (style_)
+    {
+    case Style::Exchange:
+        return std::max(phi * (spot1 - spot2), 0.0);
+    case Style::Spread:
+        return std::max(phi * (spot1 - spot2 - K_), 0.0);
+    case Style::BestOf:
+        return std::max(phi * (std::max(spot1, spot2) - K_), 0.0);
+    case Style::WorstOf:
+        return std::max(phi * (std::min(spot1, spot2) - K_), 0.0);
+    default:
+        throw std::runtime_error("Unknown two-asset payoff style");
+    }
+}
+
 /* =========================================================
    PAYOFF FACTORY
    ========================================================= */
@@ -41,8 +41,22 @@ private:
 
 // ========== OPTIONS ASIATIQUES ==========
 
+// Base commune des options asiatiques (type de moyenne)
+class AsianPayoff : public Payoff
+{
+public:
+    enum class Averaging { Arithmetic, Geometric };
+
+    AsianPayoff(double strike, OptionType type, Averaging averaging);
+
+    Averaging averaging() const { return averaging_; }
+
+private:
+    Averaging averaging_;
+};
+
 // Option asiatique (moyenne arithmétique) - Call
-class AsianCallPayoff : public Payoff
+class AsianCallPayoff : public AsianPayoff
 {
 public:
     explicit AsianCallPayoff(double strike);
@@ -50,7 +64,7 @@ public:
 };
 
 // Option asiatique (moyenne arithmétique) - Put
-class AsianPutPayoff : public Payoff
+class AsianPutPayoff : public AsianPayoff
 {
 public:
     explicit AsianPutPayoff(double strike);
@@ -58,7 +72,7 @@ public:
 };
 
 // Option asiatique (moyenne géométrique) - Call
-class AsianGeometricCallPayoff : public Payoff
+class AsianGeometricCallPayoff : public AsianPayoff
 {
 public:
     explicit AsianGeometricCallPayoff(double strike);
@@ -67,7 +81,7 @@ public:
 
 // Option asiatique (moyenne géométrique) - Put
 
-class AsianGeometricPutPayoff : public Payoff
+class AsianGeometricPutPayoff : public AsianPayoff
 {
 public:
     explicit AsianGeometricPutPayoff(double strike);
@@ -76,8 +90,26 @@ public:
 
 // ========== OPTIONS LOOKBACK ==========
 
+// Base commune des options lookback : le call suit le maximum courant,
+// le put le minimum courant
+class LookbackPayoff : public Payoff
+{
+public:
+    enum class StrikeStyle { Fixed, Floating };
+
+    LookbackPayoff(double strike, OptionType type, StrikeStyle style);
+
+    StrikeStyle strike_style() const { return style_; }
+
+    // Payoff pour un extrême courant et un spot donnés
+    double payoff_extremum(double extremum, double spot) const;
+
+private:
+    StrikeStyle style_;
+};
+
 // Option lookback (maximum) - Call
-class LookbackCallPayoff : public Payoff
+class LookbackCallPayoff : public LookbackPayoff
 {
 public:
     explicit LookbackCallPayoff(double strike);
@@ -85,7 +117,7 @@ public:
 };
 
 // Option lookback (minimum) - Put
-class LookbackPutPayoff : public Payoff
+class LookbackPutPayoff : public LookbackPayoff
 {
 public:
     explicit LookbackPutPayoff(double strike);
@@ -93,7 +125,7 @@ public:
 };
 
 // Option lookback flottant (max - S_T) - Call
-class LookbackFloatingCallPayoff : public Payoff
+class LookbackFloatingCallPayoff : public LookbackPayoff
 {
 public:
     LookbackFloatingCallPayoff();
@@ -102,7 +134,7 @@ public:
 
 // Option lookback flottant (S_T - min) - Put
 
-class LookbackFloatingPutPayoff : public Payoff
+class LookbackFloatingPutPayoff : public LookbackPayoff
 {
 public:
     LookbackFloatingPutPayoff();
@@ -111,58 +143,69 @@ public:
 
 // ========== OPTIONS BARRIÈRES ==========
 
+// Base commune des options barrières (niveau, sens et type d'activation)
+class BarrierPayoff : public Payoff
+{
+public:
+    enum class Direction { Up, Down };
+    enum class Knock { In, Out };
+
+    BarrierPayoff(double strike, OptionType type, double barrier,
+                  Direction direction, Knock knock);
+
+    double barrier() const { return barrier_; }
+    Direction direction() const { return direction_; }
+    Knock knock() const { return knock_; }
+    
+    // Vrai si le spot touche ou franchit la barrière
+    bool is_breached(double spot) const;
+
+protected:
+    double barrier_;
+
+private:
+    Direction direction_;
+    Knock knock_;
+};
+
 // Option barrière up-and-out - Call
-class BarrierUpOutCallPayoff : public Payoff
+class BarrierUpOutCallPayoff : public BarrierPayoff
 {
 public:
     BarrierUpOutCallPayoff(double strike, double barrier);
     double operator()(const std::vector<double>& path) const override;
-
-private:
-    double barrier_;
 };
 
 // Option barrière up-and-out - Put
-class BarrierUpOutPutPayoff : public Payoff
+class BarrierUpOutPutPayoff : public BarrierPayoff
 {
 public:
     BarrierUpOutPutPayoff(double strike, double barrier);
     double operator()(const std::vector<double>& path) const override;
-private:
-    double barrier_;
 };
 
 // Option barrière down-and-out - Put
-class BarrierDownOutPutPayoff : public Payoff
+class BarrierDownOutPutPayoff : public BarrierPayoff
 {
 public:
     BarrierDownOutPutPayoff(double strike, double barrier);
     double operator()(const std::vector<double>& path) const override;
-
-private:
-    double barrier_;
 };
 
 // Option barrière up-and-in - Call
-class BarrierUpInCallPayoff : public Payoff
+class BarrierUpInCallPayoff : public BarrierPayoff
 {
 public:
     BarrierUpInCallPayoff(double strike, double barrier);
     double operator()(const std::vector<double>& path) const override;
-
-private:
-    double barrier_;
 };
 
 // Option barrière down-and-in - Put
-class BarrierDownInPutPayoff : public Payoff
+class BarrierDownInPutPayoff : public BarrierPayoff
 {
 public:
     BarrierDownInPutPayoff(double strike, double barrier);
     double operator()(const std::vector<double>& path) const override;
-
-private:
-    double barrier_;
 };
 
 // ========== OPTIONS DIGITALES ==========
@@ -212,6 +255,32 @@ private:
     double power_;
 };
 
+// ========== OPTIONS SUR DEUX SOUS-JACENTS ==========
+
+// Payoff à maturité (ou à l'exercice) sur deux spots S1 et S2 :
+//   Exchange : max(S1 - S2, 0) (call), max(S2 - S1, 0) (put), sans strike
+//   Spread   : max(phi (S1 - S2 - K), 0)
+//   BestOf   : max(phi (max(S1, S2) - K), 0)
+//   WorstOf  : max(phi (min(S1, S2) - K), 0)
+class TwoAssetPayoff
+{
+public:
+    enum class Style { Exchange, Spread, BestOf, WorstOf };
+
+    TwoAssetPayoff(Style style, OptionType type, double strike = 0.0);
+
+    double operator()(double spot1, double spot2) const;
+
+    Style style() const { return style_; }
+    OptionType type() const { return type_; }
+    double strike() const { return K_; }
+
+private:
+    Style style_;
+    OptionType type_;
+    double K_;
+};
+
 // ========== FACTORY AMÉLIORÉ ==========
 
 // Factory pattern pour créer des payoffs
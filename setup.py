@@ -15,8 +15,17 @@ cpp_files = [
     'option.cpp',                    # Classe Option
     'black_scholes_pricer.cpp',      # Black-Scholes
     'monte_carlo_pricer.cpp',        # Monte Carlo
+    'mc_accumulator.cpp',            # Accumulateurs Monte Carlo fusionnables
+    'path_store.cpp',                # Stockage persistant des paths (mmap)
     'binomial_tree_pricer.cpp',      # Arbres binomiaux
+    'trinomial_barrier_pricer.cpp',  # Arbre trinomial pour barrières
+    'path_dependent_tree_pricer.cpp',  # Arbre asiatiques / lookback (Hull-White)
+    'two_asset_tree_pricer.cpp',     # Arbre à deux sous-jacents (BEG)
+    'adi_pricer.cpp',                # EDP 2D ADI (Heston, deux sous-jacents)
     'finite_difference_pricer.cpp',  # Différences finies
+    'dupire_pricer.cpp',             # EDP forward de Dupire (surface strike x maturité)
+    'exercise_boundary.cpp',         # Frontière d'exercice anticipé
+    'dividend_schedule.cpp',         # Dividendes discrets
     'replication_strategy.cpp'       # Stratégies de réplication
 ]
 
@@ -59,6 +68,8 @@ ext_modules = [
         existing_files,
         include_dirs=['.'],
         extra_compile_args=['-std=c++17', '-O3', '-Wall'], #, '-Wno-unused-variable'
+        # std::thread (arbres binomiaux multithreadés)
+        extra_link_args=[] if sys.platform == 'win32' else ['-pthread'],
         language='c++'
     ),
 ]
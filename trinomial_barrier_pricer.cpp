@@ -0,0 +1,406 @@
+#include "trinomial_barrier_pricer.hpp"
+#include "black_scholes_pricer.hpp"
+#include "binomial_tree_pricer.hpp"
+#include <cmath>
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+
+/* =========================================================
+   ARBRE TRINOMIAL BARRIÈRE - IMPLÉMENTATION
+   ========================================================= */
+
+TrinomialBarrierPricer::TrinomialBarrierPricer(const Option& option,
+                                               double spot,
+                                               double rate,
+                                               double carry,
+                                               double volatility,
+                                               std::size_t steps,
+                                               bool is_american,
+                                               std::size_t refinement_levels)
+    : option_(option),
+      S0_(spot),
+      r_(rate),
+      b_(carry),
+      sigma_(volatility),
+      N_(steps),
+      is_american_(is_american),
+      levels_(refinement_levels)
+{
+    // Validation
+    if (spot <= 0.0)
+        throw std::invalid_argument("Spot must be positive");
+    if (volatility <= 0.0)
+        throw std::invalid_argument("Volatility must be positive");
+    if (steps == 0)
+        throw std::invalid_argument("Number of steps must be positive");
+
+    const auto* barrier = dynamic_cast<const BarrierPayoff*>(&option.payoff());
+    if (!barrier)
+        throw std::invalid_argument("Trinomial barrier pricer needs a barrier payoff");
+
+    B_ = barrier->barrier();
+    up_ = barrier->direction() == BarrierPayoff::Direction::Up;
+    knock_in_ = barrier->knock() == BarrierPayoff::Knock::In;
+    breached_ = barrier->is_breached(spot);
+
+    if (!breached_)
+        build_grid();
+}
+
+void TrinomialBarrierPricer::build_grid()
+{
+    // Barrière et spot sur des nœuds : h = d / n0 avec d = |ln(S0 / B)|, puis
+    // le nombre de pas ajusté pour lambda = h / (sigma sqrt(k)) = sqrt(3).
+    // pm = 2/3 annule le terme O(k) du schéma (quatrième moment exact) : il
+    // ne reste que l'erreur de barrière et de strike, que chaque niveau de
+    // raffinement réduit
+    double T = option_.maturity();
+    double d = std::abs(std::log(S0_ / B_));
+    double target = std::sqrt(3.0 * T / static_cast<double>(N_)) * sigma_;
+
+    if (d >= target)
+    {
+        // h <= target : entre N et 4 N pas (n0 = 2, d juste au-dessus de target)
+        n0_ = static_cast<std::size_t>(std::ceil(d / target - 1e-9));
+        h_ = d / static_cast<double>(n0_);
+        N_ = std::max(N_, static_cast<std::size_t>(std::lround(3.0 * T * sigma_ * sigma_ / (h_ * h_))));
+    }
+    else
+    {
+        // Spot à moins d'un pas de la barrière : treillis demandé, barrière
+        // sur le nœud 0 et spot interpolé (zone fine qui l'encadre)
+        n0_ = 0;
+        h_ = target;
+    }
+    k_ = T / static_cast<double>(N_);
+    lambda_ = h_ / (sigma_ * std::sqrt(k_));
+
+    // y = ln(S / B) sous une barrière basse, ln(B / S) sous une barrière haute
+    mu_y_ = (b_ - 0.5 * sigma_ * sigma_) * (up_ ? -1.0 : 1.0);
+
+    double pu, pm, pd;
+    probabilities(0, pu, pm, pd);
+    if (pu < 0.0 || pd < 0.0 || pm < 0.0)
+        throw std::runtime_error("Invalid trinomial probabilities (increase the number of steps)");
+}
+
+void TrinomialBarrierPricer::probabilities(std::size_t level, double& pu, double& pm, double& pd) const
+{
+    // Même lambda à tous les niveaux ; seul le terme de drift diminue avec sqrt(k)
+    double drift = mu_y_ * std::sqrt(k_) / (2.0 * lambda_ * sigma_) / std::ldexp(1.0, static_cast<int>(level));
+    double diffusion = 0.5 / (lambda_ * lambda_);
+
+    pu = diffusion + drift;
+    pd = diffusion - drift;
+    pm = 1.0 - 2.0 * diffusion;
+}
+
+double TrinomialBarrierPricer::node_spot(std::size_t idx, std::size_t level) const
+{
+    double y = static_cast<double>(idx) * std::ldexp(h_, -static_cast<int>(level));
+    return B_ * std::exp(up_ ? -y : y);
+}
+
+/* =========================================================
+   CONDITIONS À LA BARRIÈRE ET À MATURITÉ
+   ========================================================= */
+
+double TrinomialBarrierPricer::barrier_value(double t, bool knock_in, const std::vector<double>& boundary) const
+{
+    // Knock-out sans rebate : l'option disparaît
+    if (!knock_in)
+        return 0.0;
+
+    // Knock-in : l'option devient vanille, interpolée entre deux dates grossières
+    double x = std::clamp(t / k_, 0.0, static_cast<double>(N_));
+    std::size_t n = std::min(static_cast<std::size_t>(x), N_ - 1);
+    double w = x - static_cast<double>(n);
+    return (1.0 - w) * boundary[n] + w * boundary[n + 1];
+}
+
+double TrinomialBarrierPricer::terminal_value(std::size_t idx, std::size_t level, bool knock_in) const
+{
+    double S = node_spot(idx, level);
+
+    if (idx == 0)
+        return knock_in ? option_.payoff().payoff_spot(S) : 0.0;
+
+    // Barrière jamais touchée : knock-in sans valeur, knock-out vanille
+    return knock_in ? 0.0 : option_.payoff().payoff_spot(S);
+}
+
+std::vector<double> TrinomialBarrierPricer::vanilla_at_barrier() const
+{
+    // Treillis vanille américain centré sur la barrière, même h et même k.
+    // Les bords figés ne remontent que d'un nœud par pas : ±(N + 1) suffit
+    std::size_t width = N_ + 1;
+    std::vector<double> values(2 * width + 1);
+    std::vector<double> boundary(N_ + 1);
+
+    auto spot_at = [&](std::size_t j)
+    {
+        double y = (static_cast<double>(j) - static_cast<double>(width)) * h_;
+        return B_ * std::exp(up_ ? -y : y);
+    };
+
+    for (std::size_t j = 0; j < values.size(); ++j)
+        values[j] = option_.payoff().payoff_spot(spot_at(j));
+    boundary[N_] = values[width];
+
+    double pu, pm, pd;
+    probabilities(0, pu, pm, pd);
+    double df = std::exp(-r_ * k_);
+
+    std::vector<double> next(values);
+    for (std::size_t n = N_; n-- > 0;)
+    {
+        for (std::size_t j = 1; j + 1 < values.size(); ++j)
+        {
+            double continuation = df * (pu * values[j + 1] + pm * values[j] + pd * values[j - 1]);
+            next[j] = is_american_ ? std::max(continuation, option_.payoff().payoff_spot(spot_at(j)))
+                                   : continuation;
+        }
+        std::swap(values, next);
+        boundary[n] = values[width];
+    }
+
+    return boundary;
+}
+
+/* =========================================================
+   RÉSOLUTION DU TREILLIS GROSSIER
+   ========================================================= */
+
+std::vector<double> TrinomialBarrierPricer::solve(bool knock_in, double& spacing) const
+{
+    std::vector<double> boundary;
+    if (knock_in)
+        boundary = vanilla_at_barrier();
+
+    // Nœuds 0 (barrière) à n0 + N + 3 : au pas n on met à jour 1..n0 + n + 2
+    // (nœuds 0, 1, 2 à t = 0 même si le spot n'est pas un nœud)
+    std::size_t J = n0_ + N_ + 3;
+    std::vector<double> values(J + 1);
+    for (std::size_t j = 0; j <= J; ++j)
+        values[j] = terminal_value(j, 0, knock_in);
+
+    // Avant la barrière, un knock-in n'est pas encore une option : pas d'exercice
+    bool exercise = is_american_ && !knock_in;
+
+    // Chaîne barrière : nœuds [0, 4] à chaque niveau (y dans [0, 2h / 2^(l-1)])
+    std::vector<Patch> barrier_chain;
+    for (std::size_t l = 1; l <= levels_; ++l)
+    {
+        Patch patch{l, 0, 4, true, {}};
+        for (std::size_t i = patch.lo; i <= patch.hi; ++i)
+            patch.values.push_back(terminal_value(i, l, knock_in));
+        barrier_chain.push_back(std::move(patch));
+    }
+
+    // Chaîne strike : 5 nœuds parents autour du nœud le plus proche du strike,
+    // seulement si le strike est dans la zone vivante et loin de la barrière
+    std::vector<Patch> strike_chain;
+    double K = option_.payoff().strike();
+    double y_K = (K > 0.0) ? std::log(K / B_) * (up_ ? -1.0 : 1.0) : -1.0;
+    if (levels_ > 0 && y_K > 0.0 && N_ >= kStrikeSteps)
+    {
+        std::size_t c = static_cast<std::size_t>(std::lround(y_K / h_));
+        if (c >= 3 && c + 2 <= n0_ + N_ - kStrikeSteps)
+        {
+            for (std::size_t l = 1; l <= levels_; ++l)
+            {
+                Patch patch{l, 2 * (c - 2), 2 * (c + 2), false, {}};
+                for (std::size_t i = patch.lo; i <= patch.hi; ++i)
+                    patch.values.push_back(terminal_value(i, l, knock_in));
+                strike_chain.push_back(std::move(patch));
+
+                // Centre au niveau suivant : nœud du niveau l le plus proche du strike
+                c = static_cast<std::size_t>(std::lround(y_K / std::ldexp(h_, -static_cast<int>(l))));
+            }
+        }
+    }
+
+    double pu, pm, pd;
+    probabilities(0, pu, pm, pd);
+    double df = std::exp(-r_ * k_);
+
+    std::vector<double> old(values);
+    for (std::size_t n = N_; n-- > 0;)
+    {
+        old = values;
+        double t_old = static_cast<double>(n + 1) * k_;
+        double t_new = static_cast<double>(n) * k_;
+
+        values[0] = barrier_value(t_new, knock_in, boundary);
+        for (std::size_t j = 1; j <= n0_ + n + 2; ++j)
+        {
+            double continuation = df * (pu * old[j + 1] + pm * old[j] + pd * old[j - 1]);
+            values[j] = exercise ? std::max(continuation, option_.payoff().payoff_spot(node_spot(j, 0)))
+                                 : continuation;
+        }
+
+        // Les zones fines remplacent les valeurs grossières qu'elles recouvrent
+        if (!barrier_chain.empty())
+            refine(barrier_chain, 0, old, values, 0, t_old, t_new, knock_in, boundary);
+        if (!strike_chain.empty() && n + kStrikeSteps >= N_)
+            refine(strike_chain, 0, old, values, 0, t_old, t_new, knock_in, boundary);
+    }
+
+    // Spot entre les nœuds grossiers 0 et 1 : zone barrière la plus fine
+    // dont les nœuds 0, 1, 2 l'encadrent
+    spacing = h_;
+    double d = std::abs(std::log(S0_ / B_));
+    if (n0_ == 0)
+    {
+        for (auto patch = barrier_chain.rbegin(); patch != barrier_chain.rend(); ++patch)
+        {
+            double fine = std::ldexp(h_, -static_cast<int>(patch->level));
+            if (d <= 2.0 * fine)
+            {
+                spacing = fine;
+                return patch->values;
+            }
+        }
+    }
+
+    return values;
+}
+
+/* =========================================================
+   MAILLAGE ADAPTATIF (FIGLEWSKI-GAO)
+   ========================================================= */
+
+void TrinomialBarrierPricer::refine(std::vector<Patch>& chain,
+                                   std::size_t c,
+                                   const std::vector<double>& parent_old,
+                                   std::vector<double>& parent_new,
+                                   std::size_t parent_lo,
+                                   double t_old,
+                                   double t_new,
+                                   bool knock_in,
+                                   const std::vector<double>& boundary) const
+{
+    Patch& patch = chain[c];
+    std::size_t size = patch.hi - patch.lo + 1;
+
+    double pu, pm, pd;
+    probabilities(patch.level, pu, pm, pd);
+    double dt = 0.25 * (t_old - t_new);
+    double df = std::exp(-r_ * dt);
+    bool exercise = is_american_ && !knock_in;
+
+    // Bords de la zone : nœuds parents, interpolés linéairement en temps
+    std::size_t lo_parent = patch.lo / 2 - parent_lo;
+    std::size_t hi_parent = patch.hi / 2 - parent_lo;
+
+    std::vector<double> old(size), next(size);
+    for (std::size_t s = 1; s <= 4; ++s)
+    {
+        old = patch.values;
+        double w = 0.25 * static_cast<double>(s);
+        double t = t_old - static_cast<double>(s) * dt;
+
+        next[0] = patch.at_barrier
+            ? barrier_value(t, knock_in, boundary)
+            : (1.0 - w) * parent_old[lo_parent] + w * parent_new[lo_parent];
+        next[size - 1] = (1.0 - w) * parent_old[hi_parent] + w * parent_new[hi_parent];
+
+        for (std::size_t i = 1; i + 1 < size; ++i)
+        {
+            double continuation = df * (pu * old[i + 1] + pm * old[i] + pd * old[i - 1]);
+            next[i] = exercise ? std::max(continuation, option_.payoff().payoff_spot(node_spot(patch.lo + i, patch.level)))
+                               : continuation;
+        }
+
+        // Sous-pas du niveau suivant dans ce pas fin
+        if (c + 1 < chain.size())
+            refine(chain, c + 1, old, next, patch.lo, t + dt, t, knock_in, boundary);
+
+        patch.values = next;
+    }
+
+    // Les nœuds pairs intérieurs coïncident avec des nœuds parents
+    for (std::size_t i = 2; i + 1 < size; i += 2)
+        parent_new[(patch.lo + i) / 2 - parent_lo] = patch.values[i];
+}
+
+/* =========================================================
+   PRIX ET DELTA
+   ========================================================= */
+
+double TrinomialBarrierPricer::vanilla_price() const
+{
+    Option vanilla(option_.maturity(),
+                   std::make_shared<Payoff>(option_.payoff().strike(), option_.payoff().type()));
+
+    if (is_american_)
+        return BinomialTreePricer(vanilla, S0_, r_, b_, sigma_, std::max<std::size_t>(N_, 200), true).price();
+    return BlackScholesPricer(vanilla, S0_, r_, b_, sigma_).price();
+}
+
+double TrinomialBarrierPricer::vanilla_delta() const
+{
+    Option vanilla(option_.maturity(),
+                   std::make_shared<Payoff>(option_.payoff().strike(), option_.payoff().type()));
+
+    if (is_american_)
+        return BinomialTreePricer(vanilla, S0_, r_, b_, sigma_, std::max<std::size_t>(N_, 200), true).delta(S0_);
+    return BlackScholesPricer(vanilla, S0_, r_, b_, sigma_).delta(S0_);
+}
+
+double TrinomialBarrierPricer::spot_value(const std::vector<double>& values, double spacing, double& slope) const
+{
+    if (n0_ > 0)
+    {
+        // Différence centrée sur les nœuds voisins du spot
+        slope = (values[n0_ + 1] - values[n0_ - 1]) / (node_spot(n0_ + 1, 0) - node_spot(n0_ - 1, 0));
+        return values[n0_];
+    }
+
+    // Lagrange sur y = 0, h, 2h en x = y / h ; dS / dy = ±S
+    double x = std::abs(std::log(S0_ / B_)) / spacing;
+    double value = 0.5 * (x - 1.0) * (x - 2.0) * values[0] - x * (x - 2.0) * values[1]
+                 + 0.5 * x * (x - 1.0) * values[2];
+    double dy = ((x - 1.5) * values[0] - (2.0 * x - 2.0) * values[1] + (x - 0.5) * values[2]) / spacing;
+    slope = dy / (up_ ? -S0_ : S0_);
+    return value;
+}
+
+double TrinomialBarrierPricer::price() const
+{
+    // Barrière déjà touchée : knock-out éteint, knock-in déjà vanille
+    if (breached_)
+        return knock_in_ ? vanilla_price() : 0.0;
+
+    // Knock-in européen par parité : in + out = vanille
+    double spacing, slope;
+    if (knock_in_ && !is_american_)
+    {
+        std::vector<double> values = solve(false, spacing);
+        return vanilla_price() - spot_value(values, spacing, slope);
+    }
+
+    std::vector<double> values = solve(knock_in_, spacing);
+    return spot_value(values, spacing, slope);
+}
+
+double TrinomialBarrierPricer::delta(double spot) const
+{
+    if (spot != S0_)
+    {
+        TrinomialBarrierPricer other(option_, spot, r_, b_, sigma_, N_, is_american_, levels_);
+        return other.delta(spot);
+    }
+
+    if (breached_)
+        return knock_in_ ? vanilla_delta() : 0.0;
+
+    // Pente au spot sur le treillis à t = 0 (un seul treillis)
+    bool parity = knock_in_ && !is_american_;
+    double spacing, lattice;
+    std::vector<double> values = solve(knock_in_ && !parity, spacing);
+    spot_value(values, spacing, lattice);
+
+    return parity ? vanilla_delta() - lattice : lattice;
+}
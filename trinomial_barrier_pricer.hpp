@@ -0,0 +1,109 @@
+#pragma once
+
+#include "pricer.hpp"
+#include "option.hpp"
+#include <vector>
+
+/* =========================================================
+   ARBRE TRINOMIAL – OPTIONS BARRIÈRES (MAILLAGE ADAPTATIF)
+   ========================================================= */
+
+// Treillis trinomial en log-spot dont l'espacement est ajusté pour que la
+// barrière et le spot soient exactement des nœuds (lambda = sqrt(3), entre
+// N et 4 N pas) ; à moins d'un pas de la barrière, le spot est interpolé
+// dans la zone fine qui l'encadre. Un maillage adaptatif
+// (Figlewski-Gao) raffine le treillis près de la barrière pendant toute la
+// durée de vie, et près du strike sur les premiers pas après la maturité :
+// chaque niveau divise l'espacement par 2 et le pas de temps par 4.
+// Knock-out et knock-in, exercice européen ou américain.
+class TrinomialBarrierPricer : public Pricer
+{
+public:
+    TrinomialBarrierPricer(const Option& option,
+                           double spot,
+                           double rate,
+                           double carry,
+                           double volatility,
+                           std::size_t steps,
+                           bool is_american = false,
+                           std::size_t refinement_levels = 2);
+
+    double price() const override;
+    double delta(double spot) const override;
+
+    // Paramètres du treillis grossier effectivement utilisés
+    std::size_t get_steps() const { return N_; }
+    double get_space_step() const { return h_; }
+
+private:
+    // Nombre de pas grossiers (depuis la maturité) raffinés autour du strike
+    static constexpr std::size_t kStrikeSteps = 4;
+
+    // Zone raffinée : nœuds [lo, hi] du niveau level (y = indice * h / 2^level)
+    struct Patch
+    {
+        std::size_t level;
+        std::size_t lo, hi;
+        bool at_barrier;             // Nœud lo = barrière (condition imposée)
+        std::vector<double> values;  // Valeurs sur [lo, hi] au temps courant
+    };
+
+    // Ajuste h et le nombre de pas pour placer barrière et spot sur des nœuds
+    void build_grid();
+
+    // Résolution du treillis ; knock_in : la barrière rend l'option vanille.
+    // Retourne les valeurs à t = 0 depuis la barrière, espacées de spacing :
+    // nœuds grossiers 0..n0 + 2, ou zone fine si le spot n'est pas un nœud
+    std::vector<double> solve(bool knock_in, double& spacing) const;
+
+    // Valeur vanille (américaine) à la barrière aux dates du treillis grossier
+    std::vector<double> vanilla_at_barrier() const;
+
+    // Valeur au spot sur les valeurs de solve : nœud n0, ou Lagrange
+    // quadratique en y sur les nœuds 0, 1, 2 si n0 = 0 ; slope : dV / dS
+    double spot_value(const std::vector<double>& values, double spacing, double& slope) const;
+
+    // Vanille de même strike au spot S0 (parité in/out, barrière déjà touchée)
+    double vanilla_price() const;
+    double vanilla_delta() const;
+
+    // Pas de temps d'une chaîne de zones raffinées (récursif par niveau)
+    void refine(std::vector<Patch>& chain,
+                std::size_t c,
+                const std::vector<double>& parent_old,
+                std::vector<double>& parent_new,
+                std::size_t parent_lo,
+                double t_old,
+                double t_new,
+                bool knock_in,
+                const std::vector<double>& boundary) const;
+
+    // Probabilités de transition au niveau level (pas de temps k / 4^level)
+    void probabilities(std::size_t level, double& pu, double& pm, double& pd) const;
+
+    // Spot au nœud idx du niveau level
+    double node_spot(std::size_t idx, std::size_t level) const;
+
+    // Valeur imposée à la barrière au temps t
+    double barrier_value(double t, bool knock_in, const std::vector<double>& boundary) const;
+
+    // Condition terminale au nœud idx du niveau level
+    double terminal_value(std::size_t idx, std::size_t level, bool knock_in) const;
+
+    const Option& option_;
+    double S0_, r_, b_, sigma_;
+    std::size_t N_;
+    bool is_american_;
+    std::size_t levels_;
+
+    // Géométrie du treillis (distance à la barrière y = |ln(S / B)|)
+    double B_;
+    bool up_;            // Barrière haute : zone vivante S < B
+    bool knock_in_;
+    bool breached_;      // Spot déjà au-delà de la barrière
+    double h_;           // Espacement en log-spot
+    double k_;           // Pas de temps grossier
+    double lambda_;      // h / (sigma sqrt(k))
+    double mu_y_;        // Drift de y
+    std::size_t n0_;     // Nœud du spot
+};
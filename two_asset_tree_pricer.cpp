@@ -0,0 +1,214 @@
+#include "two_asset_tree_pricer.hpp"
+#include <cmath>
+#include <algorithm>
+#include <stdexcept>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+/* =========================================================
+   ARBRE À DEUX SOUS-JACENTS - IMPLÉMENTATION
+   ========================================================= */
+
+TwoAssetTreePricer::TwoAssetTreePricer(const TwoAssetPayoff& payoff,
+                                       double maturity,
+                                       double spot1,
+                                       double spot2,
+                                       double rate,
+                                       double carry1,
+                                       double carry2,
+                                       double volatility1,
+                                       double volatility2,
+                                       double correlation,
+                                       std::size_t steps,
+                                       Exercise exercise,
+                                       std::size_t exercise_dates)
+    : payoff_(payoff),
+      T_(maturity),
+      S1_(spot1),
+      S2_(spot2),
+      r_(rate),
+      b1_(carry1),
+      b2_(carry2),
+      sigma1_(volatility1),
+      sigma2_(volatility2),
+      rho_(correlation),
+      N_(steps),
+      exercise_(exercise)
+{
+    // Validation
+    if (maturity <= 0.0)
+        throw std::invalid_argument("Maturity must be positive");
+    if (spot1 <= 0.0 || spot2 <= 0.0)
+        throw std::invalid_argument("Spots must be positive");
+    if (volatility1 <= 0.0 || volatility2 <= 0.0)
+        throw std::invalid_argument("Volatilities must be positive");
+    if (correlation < -1.0 || correlation > 1.0)
+        throw std::invalid_argument("Correlation must be in [-1, 1]");
+    if (steps == 0)
+        throw std::invalid_argument("Number of steps must be positive");
+    if (exercise == Exercise::Bermudan && (exercise_dates == 0 || exercise_dates > steps))
+        throw std::invalid_argument("Bermudan exercise needs between 1 and steps exercise dates");
+
+    // Paramètres BEG : log-spots à ±sigma_k sqrt(dt)
+    dt_ = maturity / static_cast<double>(steps);
+    double sq = std::sqrt(dt_);
+    u1_ = std::exp(sigma1_ * sq);
+    u2_ = std::exp(sigma2_ * sq);
+    df_ = std::exp(-r_ * dt_);
+
+    double m1 = (b1_ - 0.5 * sigma1_ * sigma1_) / sigma1_ * sq;
+    double m2 = (b2_ - 0.5 * sigma2_ * sigma2_) / sigma2_ * sq;
+    p_uu_ = 0.25 * (1.0 + rho_ + m1 + m2);
+    p_ud_ = 0.25 * (1.0 - rho_ + m1 - m2);
+    p_du_ = 0.25 * (1.0 - rho_ - m1 + m2);
+    p_dd_ = 0.25 * (1.0 + rho_ - m1 - m2);
+
+    if (std::min({p_uu_, p_ud_, p_du_, p_dd_}) < 0.0)
+        throw std::runtime_error("Invalid BEG probabilities (increase steps or reduce |correlation|)");
+
+    // Pas d'exercice : tous (américain), la maturité seule (européen),
+    // ou exercise_dates pas régulièrement espacés (bermudéen)
+    exercisable_.assign(steps + 1, exercise == Exercise::American ? 1 : 0);
+    exercisable_[steps] = 1;
+    if (exercise == Exercise::Bermudan)
+        for (std::size_t k = 1; k <= exercise_dates; ++k)
+            exercisable_[(k * steps + exercise_dates / 2) / exercise_dates] = 1;
+}
+
+double TwoAssetTreePricer::price() const
+{
+    return evaluate(S1_, nullptr, nullptr);
+}
+
+double TwoAssetTreePricer::delta(double spot) const
+{
+    double delta1 = 0.0;
+    evaluate(spot, &delta1, nullptr);
+    return delta1;
+}
+
+double TwoAssetTreePricer::delta2() const
+{
+    double delta2 = 0.0;
+    evaluate(S1_, nullptr, &delta2);
+    return delta2;
+}
+
+void TwoAssetTreePricer::induct_rows(const double* next, double* current, std::size_t n,
+                                     std::size_t begin, std::size_t end,
+                                     const std::vector<double>& level1,
+                                     const std::vector<double>& level2) const
+{
+    std::size_t stride = N_ + 1;
+    double uu = df_ * p_uu_, ud = df_ * p_ud_, du = df_ * p_du_, dd = df_ * p_dd_;
+    bool exercise = exercisable_[n] != 0;
+
+    // Spot k au nœud (i, n) : level_k[N + 2i - n]
+    const double* S2 = level2.data() + N_ - n;
+
+    for (std::size_t i = begin; i < end; ++i)
+    {
+        const double* low = next + i * stride;   // Ligne i du pas n + 1 (S1 descend)
+        const double* high = low + stride;       // Ligne i + 1 (S1 monte)
+        double* row = current + i * stride;
+
+        for (std::size_t j = 0; j <= n; ++j)
+            row[j] = uu * high[j + 1] + ud * high[j] + du * low[j + 1] + dd * low[j];
+
+        if (exercise)
+        {
+            double S1 = level1[N_ + 2 * i - n];
+            for (std::size_t j = 0; j <= n; ++j)
+                row[j] = std::max(row[j], payoff_(S1, S2[2 * j]));
+        }
+    }
+}
+
+double TwoAssetTreePricer::evaluate(double spot1, double* delta1, double* delta2) const
+{
+    std::size_t N = N_;
+    std::size_t stride = N + 1;
+
+    // Niveaux S_k u_k^(m - N), m = 0..2N (pas de std::pow par nœud)
+    std::vector<double> level1(2 * N + 1), level2(2 * N + 1);
+    for (std::size_t m = 0; m <= 2 * N; ++m)
+    {
+        double e = static_cast<double>(m) - static_cast<double>(N);
+        level1[m] = spot1 * std::exp(e * std::log(u1_));
+        level2[m] = S2_ * std::exp(e * std::log(u2_));
+    }
+
+    // Deux couches de (N + 1)² valeurs : le pas n est dans buffer[n % 2]
+    std::vector<double> buffer[2] = {std::vector<double>(stride * stride),
+                                     std::vector<double>(stride * stride)};
+
+    double* terminal = buffer[N % 2].data();
+    for (std::size_t i = 0; i <= N; ++i)
+        for (std::size_t j = 0; j <= N; ++j)
+            terminal[i * stride + j] = payoff_(level1[2 * i], level2[2 * j]);
+
+    // Premier pas trop petit pour être réparti
+    std::size_t small = 0;
+    while (small < N && (small + 1) * (small + 1) < kParallelNodes)
+        ++small;
+
+    std::size_t workers = threads_ ? threads_ : std::max<std::size_t>(1, std::thread::hardware_concurrency());
+    if (small >= N)
+        workers = 1;
+
+    // Grands pas : blocs de lignes par thread, barrière entre pas
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::size_t arrived = 0, generation = 0;
+    auto sync = [&]()
+    {
+        if (workers == 1)
+            return;
+        std::unique_lock<std::mutex> lock(mutex);
+        std::size_t current = generation;
+        if (++arrived == workers)
+        {
+            arrived = 0;
+            ++generation;
+            cv.notify_all();
+        }
+        else
+        {
+            cv.wait(lock, [&] { return generation != current; });
+        }
+    };
+
+    auto work = [&](std::size_t w)
+    {
+        for (std::size_t n = N; n-- > small;)
+        {
+            std::size_t rows = n + 1;
+            induct_rows(buffer[(n + 1) % 2].data(), buffer[n % 2].data(), n,
+                        w * rows / workers, (w + 1) * rows / workers, level1, level2);
+            sync();
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (std::size_t w = 1; w < workers; ++w)
+        pool.emplace_back(work, w);
+    work(0);
+    for (auto& thread : pool)
+        thread.join();
+
+    // Derniers pas sur un seul thread
+    for (std::size_t n = std::min(small, N); n-- > 0;)
+        induct_rows(buffer[(n + 1) % 2].data(), buffer[n % 2].data(), n, 0, n + 1, level1, level2);
+
+    // Deltas sur les quatre nœuds du pas 1 (moyenne sur l'autre sous-jacent)
+    const double* step1 = buffer[1].data();
+    double v_dd = step1[0], v_du = step1[1], v_ud = step1[stride], v_uu = step1[stride + 1];
+
+    if (delta1)
+        *delta1 = 0.5 * ((v_uu + v_ud) - (v_du + v_dd)) / (spot1 * (u1_ - 1.0 / u1_));
+    if (delta2)
+        *delta2 = 0.5 * ((v_uu + v_du) - (v_ud + v_dd)) / (S2_ * (u2_ - 1.0 / u2_));
+
+    return buffer[0][0];
+}
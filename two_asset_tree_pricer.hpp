@@ -0,0 +1,89 @@
+#pragma once
+
+#include "pricer.hpp"
+#include "payoff.hpp"
+#include <vector>
+
+/* =========================================================
+   ARBRE BINOMIAL À DEUX SOUS-JACENTS (BOYLE-EVNINE-GIBBS)
+   ========================================================= */
+
+// Treillis bidimensionnel : à chaque pas, les deux log-spots montent ou
+// descendent de sigma_k sqrt(dt) avec quatre probabilités qui reproduisent
+// les drifts, les variances et la corrélation (Boyle-Evnine-Gibbs). Le pas n
+// compte (n + 1)² nœuds (i hausses de S1, j hausses de S2), stockés ligne par
+// ligne avec un pas fixe : chaque nœud lit ses quatre successeurs sur deux
+// lignes contiguës. Les grands pas sont répartis par blocs de lignes entre
+// threads. Options d'échange, spread, best-of et worst-of, exercice
+// européen, américain ou bermudéen.
+class TwoAssetTreePricer : public Pricer
+{
+public:
+    enum class Exercise
+    {
+        European,
+        American,
+        Bermudan   // exercise_dates dates régulières, maturité comprise
+    };
+
+    TwoAssetTreePricer(const TwoAssetPayoff& payoff,
+                       double maturity,
+                       double spot1,
+                       double spot2,
+                       double rate,
+                       double carry1,
+                       double carry2,
+                       double volatility1,
+                       double volatility2,
+                       double correlation,
+                       std::size_t steps,
+                       Exercise exercise = Exercise::European,
+                       std::size_t exercise_dates = 0);
+
+    double price() const override;
+
+    // Delta par rapport au premier sous-jacent (nœuds du pas 1)
+    double delta(double spot) const override;
+
+    // Delta par rapport au second sous-jacent, au spot initial
+    double delta2() const;
+
+    // Threads de la remontée (0 : tous les cœurs). Seuls les grands pas sont
+    // répartis ; le résultat ne dépend pas du nombre de threads
+    void set_threads(std::size_t threads) { threads_ = threads; }
+    std::size_t threads() const { return threads_; }
+
+    std::size_t get_steps() const { return N_; }
+
+private:
+    // Prix et deltas (pas 1) pour un premier spot donné
+    double evaluate(double spot1, double* delta1, double* delta2) const;
+
+    // Remontée du pas n + 1 (next) au pas n (current) sur les lignes [begin, end)
+    void induct_rows(const double* next, double* current, std::size_t n,
+                     std::size_t begin, std::size_t end,
+                     const std::vector<double>& level1,
+                     const std::vector<double>& level2) const;
+
+    // Nœuds minimum d'un pas pour le répartir entre threads
+    static constexpr std::size_t kParallelNodes = 1 << 16;
+
+    TwoAssetPayoff payoff_;
+    double T_;
+    double S1_, S2_, r_;
+    double b1_, b2_;
+    double sigma1_, sigma2_, rho_;
+    std::size_t N_;
+    Exercise exercise_;
+
+    // Paramètres du treillis
+    double dt_;
+    double u1_, u2_;
+    double p_uu_, p_ud_, p_du_, p_dd_;  // ud : S1 monte, S2 descend
+    double df_;
+
+    // Pas où l'exercice est permis
+    std::vector<char> exercisable_;
+
+    std::size_t threads_ = 1;
+};